@@ -6,6 +6,7 @@
 #include "CommonInputTypeEnum.h"
 #include "CommonLocalPlayer.h"
 #include "Engine/GameInstance.h"
+#include "Misc/CoreDelegates.h"
 #include "GameUIManagerSubsystem.h"
 #include "GameUIPolicy.h"
 #include "PrimaryGameLayout.h"
@@ -15,6 +16,25 @@
 
 int32 UCommonUIExtensions::InputSuspensions = 0;
 
+namespace CommonUIExtensions
+{
+	struct FPlayerInputSuspension
+	{
+		/** The tokens handed out by SuspendInputForPlayer that weren't resumed yet */
+		TSet<FName> SuspendTokens;
+
+		/** Whether the common input subsystem currently has the input type filters set for this player */
+		bool bInputTypeFilterApplied = false;
+	};
+
+	static TMap<TWeakObjectPtr<const ULocalPlayer>, FPlayerInputSuspension> PlayerInputSuspensions;
+
+	static FDelegateHandle FlushInputSuspensionsHandle;
+
+	/** The input type filter reason shared by all the suspensions of a player */
+	static const FName NAME_SuspendInputForPlayer("SuspendInputForPlayer");
+}
+
 ECommonInputType UCommonUIExtensions::GetOwningPlayerInputType(const UUserWidget* WidgetContextObject)
 {
 	if (WidgetContextObject)
@@ -133,15 +153,20 @@ FName UCommonUIExtensions::SuspendInputForPlayer(APlayerController* PlayerContro
 
 FName UCommonUIExtensions::SuspendInputForPlayer(ULocalPlayer* LocalPlayer, FName SuspendReason)
 {
-	if (UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(LocalPlayer))
+	if (UCommonInputSubsystem::Get(LocalPlayer))
 	{
 		InputSuspensions++;
 		FName SuspendToken = SuspendReason;
 		SuspendToken.SetNumber(InputSuspensions);
 
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, true);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendToken, true);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendToken, true);
+		CommonUIExtensions::FPlayerInputSuspension& PlayerSuspension = CommonUIExtensions::PlayerInputSuspensions.FindOrAdd(LocalPlayer);
+		PlayerSuspension.SuspendTokens.Add(SuspendToken);
+
+		// The first suspension changes the input filter, the rest only count
+		if (PlayerSuspension.SuspendTokens.Num() == 1)
+		{
+			RequestFlushInputSuspensions();
+		}
 
 		return SuspendToken;
 	}
@@ -161,11 +186,64 @@ void UCommonUIExtensions::ResumeInputForPlayer(ULocalPlayer* LocalPlayer, FName
 		return;
 	}
 
-	if (UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(LocalPlayer))
+	if (CommonUIExtensions::FPlayerInputSuspension* PlayerSuspension = CommonUIExtensions::PlayerInputSuspensions.Find(LocalPlayer))
+	{
+		// The last resume changes the input filter, the rest only count
+		if (PlayerSuspension->SuspendTokens.Remove(SuspendToken) > 0 && PlayerSuspension->SuspendTokens.Num() == 0)
+		{
+			RequestFlushInputSuspensions();
+		}
+	}
+}
+
+bool UCommonUIExtensions::IsInputSuspendedForPlayer(const ULocalPlayer* LocalPlayer)
+{
+	const CommonUIExtensions::FPlayerInputSuspension* PlayerSuspension = CommonUIExtensions::PlayerInputSuspensions.Find(LocalPlayer);
+	return PlayerSuspension && PlayerSuspension->SuspendTokens.Num() > 0;
+}
+
+void UCommonUIExtensions::RequestFlushInputSuspensions()
+{
+	if (!CommonUIExtensions::FlushInputSuspensionsHandle.IsValid())
+	{
+		CommonUIExtensions::FlushInputSuspensionsHandle = FCoreDelegates::OnEndFrame.AddStatic(&UCommonUIExtensions::FlushInputSuspensions);
+	}
+}
+
+void UCommonUIExtensions::FlushInputSuspensions()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UCommonUIExtensions_FlushInputSuspensions);
+
+	FCoreDelegates::OnEndFrame.Remove(CommonUIExtensions::FlushInputSuspensionsHandle);
+	CommonUIExtensions::FlushInputSuspensionsHandle.Reset();
+
+	for (auto It = CommonUIExtensions::PlayerInputSuspensions.CreateIterator(); It; ++It)
 	{
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, false);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendToken, false);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendToken, false);
+		CommonUIExtensions::FPlayerInputSuspension& PlayerSuspension = It.Value();
+		const bool bSuspendInput = PlayerSuspension.SuspendTokens.Num() > 0;
+
+		UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(It.Key().Get());
+		if (CommonInputSubsystem == nullptr)
+		{
+			// The player is gone, and its input subsystem with it
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (PlayerSuspension.bInputTypeFilterApplied != bSuspendInput)
+		{
+			const FName& SuspendReason = CommonUIExtensions::NAME_SuspendInputForPlayer;
+			CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendReason, bSuspendInput);
+			CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendReason, bSuspendInput);
+			CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendReason, bSuspendInput);
+
+			PlayerSuspension.bInputTypeFilterApplied = bSuspendInput;
+		}
+
+		if (!bSuspendInput)
+		{
+			It.RemoveCurrent();
+		}
 	}
 }
 
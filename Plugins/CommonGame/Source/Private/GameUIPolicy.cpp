@@ -1,7 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameUIPolicy.h"
+#include "CommonActivatableWidget.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "Framework/Application/SlateApplication.h"
 #include "GameUIManagerSubsystem.h"
 #include "CommonLocalPlayer.h"
@@ -11,6 +14,17 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameUIPolicy)
 
+static FAutoConsoleCommandWithWorld DumpWarmWidgetClassStatsCommand(
+	TEXT("CommonGame.DumpWarmWidgetClassStats"),
+	TEXT("Logs how many layer pushes of the current UI policy found their widget class warm"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UGameUIPolicy* Policy = UGameUIPolicy::GetGameUIPolicy(World))
+		{
+			Policy->DumpWarmWidgetClassStats();
+		}
+	}));
+
 // Static
 UGameUIPolicy* UGameUIPolicy::GetGameUIPolicy(const UObject* WorldContextObject)
 {
@@ -193,6 +207,8 @@ void UGameUIPolicy::CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer)
 			RootViewportLayouts.Emplace(LocalPlayer, NewLayoutObject, true);
 			
 			AddLayoutToViewport(LocalPlayer, NewLayoutObject);
+
+			PrefetchWarmWidgetClasses();
 		}
 	}
 }
@@ -201,3 +217,53 @@ TSubclassOf<UPrimaryGameLayout> UGameUIPolicy::GetLayoutWidgetClass(UCommonLocal
 {
 	return LayoutClass.LoadSynchronous();
 }
+
+void UGameUIPolicy::PrefetchWarmWidgetClasses()
+{
+	if (WarmWidgetClassesHandle.IsValid() || WarmWidgetClasses.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> WarmWidgetClassPathsToLoad;
+	for (const TSoftClassPtr<UCommonActivatableWidget>& WarmWidgetClass : WarmWidgetClasses)
+	{
+		if (!WarmWidgetClass.IsNull())
+		{
+			WarmWidgetClassPaths.Add(WarmWidgetClass.ToSoftObjectPath());
+			WarmWidgetClassPathsToLoad.Add(WarmWidgetClass.ToSoftObjectPath());
+		}
+	}
+
+	UE_LOG(LogCommonGame, Log, TEXT("[%s] is prefetching %d warm widget classes"), *GetName(), WarmWidgetClassPathsToLoad.Num());
+
+	WarmWidgetClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(WarmWidgetClassPathsToLoad));
+}
+
+UClass* UGameUIPolicy::FindWarmWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass)
+{
+	UClass* LoadedWidgetClass = WarmWidgetClassPaths.Contains(WidgetClass.ToSoftObjectPath()) ? WidgetClass.Get() : nullptr;
+	if (LoadedWidgetClass)
+	{
+		NumWarmWidgetClassHits++;
+	}
+	else
+	{
+		NumWarmWidgetClassMisses++;
+	}
+
+	return LoadedWidgetClass;
+}
+
+void UGameUIPolicy::DumpWarmWidgetClassStats() const
+{
+	const int32 NumLookups = NumWarmWidgetClassHits + NumWarmWidgetClassMisses;
+	const float HitRate = NumLookups > 0 ? 100.0f * NumWarmWidgetClassHits / NumLookups : 0.0f;
+	UE_LOG(LogCommonGame, Display, TEXT("[%s] warm widget classes: %d declared, %d hits, %d misses (%.1f%% hit rate)"),
+		*GetName(), WarmWidgetClasses.Num(), NumWarmWidgetClassHits, NumWarmWidgetClassMisses, HitRate);
+
+	for (const TSoftClassPtr<UCommonActivatableWidget>& WarmWidgetClass : WarmWidgetClasses)
+	{
+		UE_LOG(LogCommonGame, Display, TEXT("  %s%s"), *WarmWidgetClass.ToString(), WarmWidgetClass.Get() ? TEXT("") : TEXT(" (not loaded)"));
+	}
+}
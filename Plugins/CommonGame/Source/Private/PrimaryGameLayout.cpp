@@ -2,7 +2,10 @@
 
 #include "PrimaryGameLayout.h"
 
+#include "Algo/Count.h"
+#include "Blueprint/WidgetTree.h"
 #include "CommonLocalPlayer.h"
+#include "CommonRecyclableWidgetInterface.h"
 #include "Engine/GameInstance.h"
 #include "GameUIManagerSubsystem.h"
 #include "GameUIPolicy.h"
@@ -14,6 +17,45 @@
 
 class UObject;
 
+static FAutoConsoleCommandWithWorld DumpRecycledWidgetsCommand(
+	TEXT("CommonGame.DumpRecycledWidgets"),
+	TEXT("Logs the widget instances kept by the recycling layers of the primary player's root layout"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UPrimaryGameLayout* RootLayout = World ? UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(World) : nullptr)
+		{
+			RootLayout->DumpRecycledWidgets();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld FlushRecycledWidgetsCommand(
+	TEXT("CommonGame.FlushRecycledWidgets"),
+	TEXT("Frees the widget instances kept by the recycling layers of the primary player's root layout"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UPrimaryGameLayout* RootLayout = World ? UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(World) : nullptr)
+		{
+			RootLayout->FlushRecycledWidgets();
+		}
+	}));
+
+namespace PrimaryGameLayout
+{
+	static int64 EstimateWidgetMemory(UUserWidget& Widget)
+	{
+		int64 MemoryBytes = Widget.GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		if (Widget.WidgetTree)
+		{
+			Widget.WidgetTree->ForEachWidget([&MemoryBytes](UWidget* ChildWidget)
+			{
+				MemoryBytes += ChildWidget->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			});
+		}
+
+		return MemoryBytes;
+	}
+}
+
 /*static*/ UPrimaryGameLayout* UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(const UObject* WorldContextObject)
 {
 	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
@@ -54,6 +96,17 @@ UPrimaryGameLayout::UPrimaryGameLayout(const FObjectInitializer& ObjectInitializ
 {
 }
 
+void UPrimaryGameLayout::BeginDestroy()
+{
+	if (RecycleRemovedWidgetsHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RecycleRemovedWidgetsHandle);
+		RecycleRemovedWidgetsHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
 void UPrimaryGameLayout::SetIsDormant(bool InDormant)
 {
 	if (bIsDormant != InDormant)
@@ -114,6 +167,12 @@ void UPrimaryGameLayout::OnWidgetStackTransitioning(UCommonActivatableWidgetCont
 			const FName SuspendToken = SuspendInputTokens.Pop();
 			UCommonUIExtensions::ResumeInputForPlayer(GetOwningLocalPlayer(), SuspendToken);
 		}
+
+		// Widgets popped by the transition may be done with their layer now
+		if (TrackedRecyclableWidgets.Num() > 0)
+		{
+			RequestRecycleRemovedWidgets();
+		}
 	}
 }
 
@@ -130,3 +189,144 @@ UCommonActivatableWidgetContainerBase* UPrimaryGameLayout::GetLayerWidget(FGamep
 {
 	return Layers.FindRef(LayerName);
 }
+
+bool UPrimaryGameLayout::IsRecyclingWidgetClass(FGameplayTag LayerName, UClass* ActivatableWidgetClass) const
+{
+	if (const FPrimaryGameLayoutLayerRecycling* Recycling = LayerRecycling.Find(LayerName))
+	{
+		return ActivatableWidgetClass && Recycling->WidgetClasses.Contains(TSoftClassPtr<UCommonActivatableWidget>(ActivatableWidgetClass));
+	}
+
+	return false;
+}
+
+UCommonActivatableWidget* UPrimaryGameLayout::TakeRecycledWidget(FGameplayTag LayerName, UClass* ActivatableWidgetClass)
+{
+	const int32 RecycledIndex = RecycledWidgets.IndexOfByPredicate([LayerName, ActivatableWidgetClass](const FPrimaryGameLayoutRecycledWidget& RecycledWidget)
+	{
+		return RecycledWidget.LayerName == LayerName && RecycledWidget.Widget && RecycledWidget.Widget->GetClass() == ActivatableWidgetClass;
+	});
+
+	if (RecycledIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	UCommonActivatableWidget* Widget = RecycledWidgets[RecycledIndex].Widget;
+	RecycledWidgetMemoryBytes -= RecycledWidgets[RecycledIndex].MemoryBytes;
+	RecycledWidgets.RemoveAtSwap(RecycledIndex);
+
+	if (Widget->Implements<UCommonRecyclableWidgetInterface>())
+	{
+		ICommonRecyclableWidgetInterface::Execute_ResetForReuse(Widget);
+	}
+
+	return Widget;
+}
+
+void UPrimaryGameLayout::TrackRecyclableWidget(FGameplayTag LayerName, UCommonActivatableWidget& ActivatableWidget)
+{
+	TrackedRecyclableWidgets.Emplace(&ActivatableWidget, LayerName);
+
+	// Popping a widget deactivates it, it leaves the layer right after
+	ActivatableWidget.OnDeactivated().RemoveAll(this);
+	ActivatableWidget.OnDeactivated().AddUObject(this, &ThisClass::RequestRecycleRemovedWidgets);
+}
+
+void UPrimaryGameLayout::RequestRecycleRemovedWidgets()
+{
+	if (RecycleRemovedWidgetsHandle.IsValid())
+	{
+		return;
+	}
+
+	RecycleRemovedWidgetsHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+	{
+		RecycleRemovedWidgetsHandle.Reset();
+		RecycleRemovedWidgets();
+		return false;
+	}));
+}
+
+void UPrimaryGameLayout::RecycleRemovedWidgets()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UPrimaryGameLayout_RecycleRemovedWidgets);
+
+	for (int32 TrackedIndex = TrackedRecyclableWidgets.Num() - 1; TrackedIndex >= 0; TrackedIndex--)
+	{
+		UCommonActivatableWidget* Widget = TrackedRecyclableWidgets[TrackedIndex].Key.Get();
+		const FGameplayTag LayerName = TrackedRecyclableWidgets[TrackedIndex].Value;
+
+		// Widgets still on their layer (active, or covered by another widget) aren't done yet
+		UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+		if (Widget && (Widget->IsActivated() || (Layer && Layer->GetWidgetList().Contains(Widget))))
+		{
+			continue;
+		}
+
+		TrackedRecyclableWidgets.RemoveAtSwap(TrackedIndex);
+
+		if (Widget == nullptr)
+		{
+			continue;
+		}
+
+		Widget->OnDeactivated().RemoveAll(this);
+
+		const FPrimaryGameLayoutLayerRecycling* Recycling = LayerRecycling.Find(LayerName);
+		if (Recycling == nullptr)
+		{
+			continue;
+		}
+
+		const int32 NumRecycledOfClass = Algo::CountIf(RecycledWidgets, [Widget, LayerName](const FPrimaryGameLayoutRecycledWidget& RecycledWidget)
+		{
+			return RecycledWidget.LayerName == LayerName && RecycledWidget.Widget && RecycledWidget.Widget->GetClass() == Widget->GetClass();
+		});
+
+		if (NumRecycledOfClass >= Recycling->MaxInstancesPerClass)
+		{
+			continue;
+		}
+
+		const int64 MemoryBytes = PrimaryGameLayout::EstimateWidgetMemory(*Widget);
+		if (MaxRecycledWidgetMemoryKB > 0 && RecycledWidgetMemoryBytes + MemoryBytes > (int64)MaxRecycledWidgetMemoryKB * 1024)
+		{
+			UE_LOG(LogCommonGame, Verbose, TEXT("Not recycling [%s], the recycled widgets would go over %d KB"), *GetNameSafe(Widget), MaxRecycledWidgetMemoryKB);
+			continue;
+		}
+
+		FPrimaryGameLayoutRecycledWidget& RecycledWidget = RecycledWidgets.AddDefaulted_GetRef();
+		RecycledWidget.Widget = Widget;
+		RecycledWidget.LayerName = LayerName;
+		RecycledWidget.MemoryBytes = MemoryBytes;
+		RecycledWidgetMemoryBytes += MemoryBytes;
+	}
+}
+
+void UPrimaryGameLayout::FlushRecycledWidgets()
+{
+	RecycledWidgets.Reset();
+	RecycledWidgetMemoryBytes = 0;
+}
+
+void UPrimaryGameLayout::DumpRecycledWidgets() const
+{
+	UE_LOG(LogCommonGame, Display, TEXT("[%s] is keeping %d recycled widgets (%.1f KB), tracking %d on recycling layers"),
+		*GetName(), RecycledWidgets.Num(), RecycledWidgetMemoryBytes / 1024.0, TrackedRecyclableWidgets.Num());
+
+	for (const FPrimaryGameLayoutRecycledWidget& RecycledWidget : RecycledWidgets)
+	{
+		UE_LOG(LogCommonGame, Display, TEXT("  [%s] %s (%.1f KB)"), *RecycledWidget.LayerName.ToString(), *GetNameSafe(RecycledWidget.Widget), RecycledWidget.MemoryBytes / 1024.0);
+	}
+}
+
+UClass* UPrimaryGameLayout::FindWarmWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& ActivatableWidgetClass) const
+{
+	if (UGameUIPolicy* Policy = UGameUIPolicy::GetGameUIPolicy(this))
+	{
+		return Policy->FindWarmWidgetClass(ActivatableWidgetClass);
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "CommonRecyclableWidgetInterface.generated.h"
+
+/** Interface for activatable widgets whose instances are reused by the layers of a primary game layout (see UPrimaryGameLayout::LayerRecycling) */
+UINTERFACE(MinimalAPI, BlueprintType)
+class UCommonRecyclableWidgetInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICommonRecyclableWidgetInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Called on a deactivated instance before it's pushed to its layer again, it should put itself back in the state
+	// a newly created instance would be in
+	UFUNCTION(BlueprintNativeEvent, Category = "Recycling")
+	void ResetForReuse();
+
+	virtual void ResetForReuse_Implementation() {}
+};
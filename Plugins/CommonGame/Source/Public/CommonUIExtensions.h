@@ -59,6 +59,18 @@ public:
 
 	static UE_API void ResumeInputForPlayer(ULocalPlayer* LocalPlayer, FName SuspendToken);
 
+	/** True while the player has suspend tokens that weren't resumed yet (the input filter itself is updated at the end of the frame). */
+	static UE_API bool IsInputSuspendedForPlayer(const ULocalPlayer* LocalPlayer);
+
+private:
+	/**
+	 * Applies the suspensions that changed this frame to the common input subsystems.  The input type filters are only
+	 * touched when a player goes from no suspension to some or back, so suspending and resuming within a frame is free.
+	 */
+	static UE_API void FlushInputSuspensions();
+
+	static UE_API void RequestFlushInputSuspensions();
+
 private:
 	static UE_API int32 InputSuspensions;
 };
@@ -3,15 +3,18 @@
 #pragma once
 
 #include "Engine/World.h"
+#include "UObject/SoftObjectPath.h"
 
 #include "GameUIPolicy.generated.h"
 
 #define UE_API COMMONGAME_API
 
+class UCommonActivatableWidget;
 class UCommonLocalPlayer;
 class UGameUIManagerSubsystem;
 class ULocalPlayer;
 class UPrimaryGameLayout;
+struct FStreamableHandle;
 
 /**
  * 
@@ -76,6 +79,18 @@ public:
 
 	UE_API void RequestPrimaryControl(UPrimaryGameLayout* Layout);
 
+	/**
+	 * Returns the widget class if it's one of the WarmWidgetClasses and has finished loading, so it can be pushed
+	 * right away.  Every lookup counts as a hit or a miss in the warm widget class stats.
+	 */
+	UE_API UClass* FindWarmWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass);
+
+	/** Logs how many of the widget class lookups (see FindWarmWidgetClass) were warm. */
+	UE_API void DumpWarmWidgetClassStats() const;
+
+	int32 GetNumWarmWidgetClassHits() const { return NumWarmWidgetClassHits; }
+	int32 GetNumWarmWidgetClassMisses() const { return NumWarmWidgetClassMisses; }
+
 protected:
 	UE_API void AddLayoutToViewport(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* Layout);
 	UE_API void RemoveLayoutFromViewport(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* Layout);
@@ -87,12 +102,27 @@ protected:
 	UE_API void CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer);
 	UE_API TSubclassOf<UPrimaryGameLayout> GetLayoutWidgetClass(UCommonLocalPlayer* LocalPlayer);
 
+	/** Starts loading the WarmWidgetClasses, they are then kept loaded for as long as this policy exists. */
+	UE_API void PrefetchWarmWidgetClasses();
+
 private:
 	ELocalMultiplayerInteractionMode LocalMultiplayerInteractionMode = ELocalMultiplayerInteractionMode::PrimaryOnly;
 
 	UPROPERTY(EditAnywhere)
 	TSoftClassPtr<UPrimaryGameLayout> LayoutClass;
 
+	// Screens that are opened often (pause, scoreboard, inventory...), loaded once the first root layout is created and
+	// kept loaded, so pushing them to a layer (see UPrimaryGameLayout::PushWidgetToLayerStackAsync) doesn't wait on a load
+	UPROPERTY(EditAnywhere)
+	TArray<TSoftClassPtr<UCommonActivatableWidget>> WarmWidgetClasses;
+
+	TSet<FSoftObjectPath> WarmWidgetClassPaths;
+
+	TSharedPtr<FStreamableHandle> WarmWidgetClassesHandle;
+
+	int32 NumWarmWidgetClassHits = 0;
+	int32 NumWarmWidgetClassMisses = 0;
+
 	UPROPERTY(Transient)
 	TArray<FRootViewportLayoutInfo> RootViewportLayouts;
 
@@ -6,6 +6,7 @@
 #include "CommonUIExtensions.h"
 #include "Engine/AssetManager.h"
 #include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "Widgets/CommonActivatableWidgetContainer.h" // IWYU pragma: keep
 
@@ -30,6 +31,43 @@ enum class EAsyncWidgetLayerState : uint8
 	AfterPush
 };
 
+/**
+ * Which widget classes a layer of the primary game layout recycles, see UPrimaryGameLayout::LayerRecycling.
+ */
+USTRUCT()
+struct FPrimaryGameLayoutLayerRecycling
+{
+	GENERATED_BODY()
+
+public:
+	// The widget classes whose deactivated instances are kept to be pushed again
+	UPROPERTY(EditAnywhere, Category = Recycling)
+	TArray<TSoftClassPtr<UCommonActivatableWidget>> WidgetClasses;
+
+	// How many deactivated instances of each class are kept
+	UPROPERTY(EditAnywhere, Category = Recycling, meta = (ClampMin = 1))
+	int32 MaxInstancesPerClass = 1;
+};
+
+/**
+ * A deactivated widget instance kept by the primary game layout to be pushed to its layer again.
+ */
+USTRUCT()
+struct FPrimaryGameLayoutRecycledWidget
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonActivatableWidget> Widget = nullptr;
+
+	UPROPERTY(Transient)
+	FGameplayTag LayerName;
+
+	// Estimated memory held by the instance and its widget tree
+	int64 MemoryBytes = 0;
+};
+
 /**
  * The primary game UI layout of your game.  This widget class represents how to layout, push and display all layers
  * of the UI for a single player.  Each player in a split-screen game will receive their own primary game layout.
@@ -47,6 +85,10 @@ public:
 public:
 	UE_API UPrimaryGameLayout(const FObjectInitializer& ObjectInitializer);
 
+	//~UObject interface
+	UE_API virtual void BeginDestroy() override;
+	//~End of UObject interface
+
 	/** A dormant root layout is collapsed and responds only to persistent actions registered by the owning player */
 	UE_API void SetIsDormant(bool Dormant);
 	bool IsDormant() const { return bIsDormant; }
@@ -58,11 +100,26 @@ public:
 		return PushWidgetToLayerStackAsync<ActivatableWidgetT>(LayerName, bSuspendInputUntilComplete, ActivatableWidgetClass, [](EAsyncWidgetLayerState, ActivatableWidgetT*) {});
 	}
 
+	/**
+	 * Loads the widget class and pushes it to the layer once loaded.  Classes the UI policy keeps warm (see
+	 * UGameUIPolicy::WarmWidgetClasses) are pushed right away instead, without suspending input, and no handle is returned.
+	 */
 	template <typename ActivatableWidgetT = UCommonActivatableWidget>
 	TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass, TFunction<void(EAsyncWidgetLayerState, ActivatableWidgetT*)> StateFunc)
 	{
 		static_assert(TIsDerivedFrom<ActivatableWidgetT, UCommonActivatableWidget>::IsDerived, "Only CommonActivatableWidgets can be used here");
 
+		if (UClass* WarmWidgetClass = FindWarmWidgetClass(ActivatableWidgetClass))
+		{
+			ActivatableWidgetT* Widget = PushWidgetToLayerStack<ActivatableWidgetT>(LayerName, WarmWidgetClass, [StateFunc](ActivatableWidgetT& WidgetToInit) {
+				StateFunc(EAsyncWidgetLayerState::Initialize, &WidgetToInit);
+			});
+
+			StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
+
+			return nullptr;
+		}
+
 		static FName NAME_PushingWidgetToLayer("PushingWidgetToLayer");
 		const FName SuspendInputToken = bSuspendInputUntilComplete ? UCommonUIExtensions::SuspendInputForPlayer(GetOwningPlayer(), NAME_PushingWidgetToLayer) : NAME_None;
 
@@ -105,6 +162,26 @@ public:
 
 		if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
 		{
+			if (IsRecyclingWidgetClass(LayerName, ActivatableWidgetClass))
+			{
+				// Recycled instances are created and kept by us rather than the layer's own pool, so that the layer can't
+				// hand them out again while we hold on to them.
+				ActivatableWidgetT* Widget = Cast<ActivatableWidgetT>(TakeRecycledWidget(LayerName, ActivatableWidgetClass));
+				if (Widget == nullptr)
+				{
+					Widget = CreateWidget<ActivatableWidgetT>(GetOwningPlayer(), ActivatableWidgetClass);
+				}
+
+				if (Widget)
+				{
+					InitInstanceFunc(*Widget);
+					Layer->AddWidgetInstance(*Widget);
+					TrackRecyclableWidget(LayerName, *Widget);
+				}
+
+				return Widget;
+			}
+
 			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
 		}
 
@@ -117,6 +194,20 @@ public:
 	// Get the layer widget for the given layer tag.
 	UE_API UCommonActivatableWidgetContainerBase* GetLayerWidget(FGameplayTag LayerName);
 
+	// Get the widget class if the current UI policy keeps it warm, see UGameUIPolicy::FindWarmWidgetClass.
+	UE_API UClass* FindWarmWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& ActivatableWidgetClass) const;
+
+	// True if the layer keeps deactivated instances of this widget class, see LayerRecycling.
+	UE_API bool IsRecyclingWidgetClass(FGameplayTag LayerName, UClass* ActivatableWidgetClass) const;
+
+	// Frees every recycled widget instance kept by the layers.
+	UE_API void FlushRecycledWidgets();
+
+	// Logs the recycled widget instances kept by the layers and the memory they hold.
+	UE_API void DumpRecycledWidgets() const;
+
+	int64 GetRecycledWidgetMemoryBytes() const { return RecycledWidgetMemoryBytes; }
+
 protected:
 	/** Register a layer that widgets can be pushed onto. */
 	UFUNCTION(BlueprintCallable, Category="Layer")
@@ -125,6 +216,27 @@ protected:
 	UE_API virtual void OnIsDormantChanged();
 
 	UE_API void OnWidgetStackTransitioning(UCommonActivatableWidgetContainerBase* Widget, bool bIsTransitioning);
+
+	// Takes a kept instance of this class for the layer and resets it (see ICommonRecyclableWidgetInterface), or returns null.
+	UE_API UCommonActivatableWidget* TakeRecycledWidget(FGameplayTag LayerName, UClass* ActivatableWidgetClass);
+
+	// Watches an instance pushed to a recycling layer, so it's kept once it leaves the layer.
+	UE_API void TrackRecyclableWidget(FGameplayTag LayerName, UCommonActivatableWidget& ActivatableWidget);
+
+	// Keeps the tracked instances that have left their layer, up to the recycling limits.
+	UE_API void RecycleRemovedWidgets();
+
+	UE_API void RequestRecycleRemovedWidgets();
+
+protected:
+	// Layers that keep deactivated instances of some widget classes to push again, instead of creating new ones.
+	// Widgets implementing ICommonRecyclableWidgetInterface are reset before they are reused.
+	UPROPERTY(EditAnywhere, Category = Recycling, meta = (Categories = "UI.Layer"))
+	TMap<FGameplayTag, FPrimaryGameLayoutLayerRecycling> LayerRecycling;
+
+	// Total memory the recycled instances can hold, further instances are let go (0 = no limit)
+	UPROPERTY(EditAnywhere, Category = Recycling, meta = (ForceUnits = KB))
+	int32 MaxRecycledWidgetMemoryKB = 0;
 	
 private:
 	bool bIsDormant = false;
@@ -136,6 +248,17 @@ private:
 	// The registered layers for the primary layout.
 	UPROPERTY(Transient, meta = (Categories = "UI.Layer"))
 	TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+
+	// Deactivated instances kept by the recycling layers.
+	UPROPERTY(Transient)
+	TArray<FPrimaryGameLayoutRecycledWidget> RecycledWidgets;
+
+	// Instances on a recycling layer, and the layer they were pushed to.
+	TArray<TPair<TWeakObjectPtr<UCommonActivatableWidget>, FGameplayTag>> TrackedRecyclableWidgets;
+
+	int64 RecycledWidgetMemoryBytes = 0;
+
+	FTSTicker::FDelegateHandle RecycleRemovedWidgetsHandle;
 };
 
 #undef UE_API
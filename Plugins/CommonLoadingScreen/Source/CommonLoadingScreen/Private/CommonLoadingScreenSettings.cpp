@@ -8,5 +8,12 @@
 UCommonLoadingScreenSettings::UCommonLoadingScreenSettings()
 {
 	CategoryName = TEXT("Game");
+
+	// Give the async loader as much of the frame as it wants while nothing else needs it
+	LoadingPhaseConsoleVariables.Add(TEXT("s.AsyncLoadingTimeLimit"), TEXT("20.0"));
+	LoadingPhaseConsoleVariables.Add(TEXT("s.AsyncLoadingUseFullTimeLimit"), TEXT("1"));
+	LoadingPhaseConsoleVariables.Add(TEXT("s.PriorityAsyncLoadingExtraTime"), TEXT("20.0"));
+	LoadingPhaseConsoleVariables.Add(TEXT("s.LevelStreamingActorsUpdateTimeLimit"), TEXT("20.0"));
+	LoadingPhaseConsoleVariables.Add(TEXT("s.UnregisterComponentsTimeLimit"), TEXT("20.0"));
 }
 
@@ -38,6 +38,37 @@ public:
  	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenAdditionalSecs"))
 	float HoldLoadingScreenAdditionalSecs = 2.0f;
 
+	// When true, the loading screen is held up after other loading finishes until texture streaming,
+	// shader precompilation and async loading report ready, instead of for HoldLoadingScreenAdditionalSecs
+ 	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenUntilReady"))
+	bool HoldLoadingScreenUntilReady = true;
+
+	// Minimum time to hold the loading screen up after other loading finishes (when HoldLoadingScreenUntilReady)
+ 	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenMinSecs"))
+	float HoldLoadingScreenMinSecs = 0.25f;
+
+	// Maximum time to wait on the readiness signals before dropping the loading screen anyways (when HoldLoadingScreenUntilReady)
+ 	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenMaxSecs"))
+	float HoldLoadingScreenMaxSecs = 10.0f;
+
+	// Texture streaming is considered ready once at most this many textures are still waiting on mips
+ 	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenMaxWantingTextures"))
+	int32 HoldLoadingScreenMaxWantingTextures = 16;
+
+	// When true, LoadingPhaseConsoleVariables and LoadingPhaseMaxFPS are applied while the loading screen
+	// is up and restored when it is hidden
+ 	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ConsoleVariable="CommonLoadingScreen.UseLoadingPerformanceProfile"))
+	bool UseLoadingPerformanceProfile = true;
+
+	// Console variables to override while the loading screen is up (e.g., async loading time slices), restored on hide.
+	// Only variables still at their default or ini value are overridden.
+	UPROPERTY(config, EditAnywhere, Category=Performance)
+	TMap<FName, FString> LoadingPhaseConsoleVariables;
+
+	// Frame rate cap while the loading screen is up, there is no point rendering a loading screen at uncapped rates (0 = no cap)
+ 	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ForceUnits=Hz))
+	float LoadingPhaseMaxFPS = 30.0f;
+
 	// The interval in seconds beyond which the loading screen is considered permanently hung (if non-zero).
  	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s))
 	float LoadingScreenHeartbeatHangDuration = 0.0f;
@@ -20,7 +20,11 @@
 #include "PreLoadScreen.h"
 #include "PreLoadScreenManager.h"
 
+#include "ContentStreaming.h"
 #include "ShaderPipelineCache.h"
+#if WITH_EDITOR
+#include "ShaderCompiler.h"
+#endif
 #include "CommonLoadingScreenSettings.h"
 
 //@TODO: Used as the placeholder widget in error cases, should probably create a wrapper that at least centers it/etc...
@@ -76,6 +80,41 @@ namespace LoadingScreenCVars
 		TEXT("How long to hold the loading screen up after other loading finishes (in seconds) to try to give texture streaming a chance to avoid blurriness"),
 		ECVF_Default | ECVF_Preview);
 
+	static bool HoldLoadingScreenUntilReady = true;
+	static FAutoConsoleVariableRef CVarHoldLoadingScreenUntilReady(
+		TEXT("CommonLoadingScreen.HoldLoadingScreenUntilReady"),
+		HoldLoadingScreenUntilReady,
+		TEXT("When true, the loading screen is held up after other loading finishes until texture streaming, shader precompilation and async loading are done (bounded by HoldLoadingScreenMinSecs/HoldLoadingScreenMaxSecs) instead of for a fixed HoldLoadingScreenAdditionalSecs"),
+		ECVF_Default | ECVF_Preview);
+
+	static float HoldLoadingScreenMinSecs = 0.25f;
+	static FAutoConsoleVariableRef CVarHoldLoadingScreenMinSecs(
+		TEXT("CommonLoadingScreen.HoldLoadingScreenMinSecs"),
+		HoldLoadingScreenMinSecs,
+		TEXT("Minimum time (in seconds) to hold the loading screen up after other loading finishes, so the world gets rendered and texture streaming can work out what it needs"),
+		ECVF_Default | ECVF_Preview);
+
+	static float HoldLoadingScreenMaxSecs = 10.0f;
+	static FAutoConsoleVariableRef CVarHoldLoadingScreenMaxSecs(
+		TEXT("CommonLoadingScreen.HoldLoadingScreenMaxSecs"),
+		HoldLoadingScreenMaxSecs,
+		TEXT("Maximum time (in seconds) to wait for the readiness signals after other loading finishes before dropping the loading screen anyways"),
+		ECVF_Default | ECVF_Preview);
+
+	static int32 HoldLoadingScreenMaxWantingTextures = 16;
+	static FAutoConsoleVariableRef CVarHoldLoadingScreenMaxWantingTextures(
+		TEXT("CommonLoadingScreen.HoldLoadingScreenMaxWantingTextures"),
+		HoldLoadingScreenMaxWantingTextures,
+		TEXT("Texture streaming is considered ready once at most this many streamed textures are still waiting on mips"),
+		ECVF_Default | ECVF_Preview);
+
+	static bool UseLoadingPerformanceProfile = true;
+	static FAutoConsoleVariableRef CVarUseLoadingPerformanceProfile(
+		TEXT("CommonLoadingScreen.UseLoadingPerformanceProfile"),
+		UseLoadingPerformanceProfile,
+		TEXT("When true, the loading-phase console variable overrides and frame rate cap from the loading screen settings are applied while the loading screen is up"),
+		ECVF_Default);
+
 	static bool LogLoadingScreenReasonEveryFrame = false;
 	static FAutoConsoleVariableRef CVarLogLoadingScreenReasonEveryFrame(
 		TEXT("CommonLoadingScreen.LogLoadingScreenReasonEveryFrame"),
@@ -140,6 +179,9 @@ void ULoadingScreenManager::Deinitialize()
 
 	RemoveWidgetFromViewport();
 
+	// Make sure we don't leave the loading-phase console variable overrides behind
+	ApplyLoadingPerformanceProfile(/*bEnable=*/ false);
+
 	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 
@@ -434,36 +476,150 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 	{
 		// Still need to show it
 		TimeLoadingScreenLastDismissed = -1.0;
+		bReadinessHoldReleased = false;
 	}
 	else
 	{
 		// Don't *need* to show the screen anymore, but might still want to for a bit
 		const double CurrentTime = FPlatformTime::Seconds();
 		const bool bCanHoldLoadingScreen = (!GIsEditor || Settings->HoldLoadingScreenAdditionalSecsEvenInEditor);
-		const double HoldLoadingScreenAdditionalSecs = bCanHoldLoadingScreen ? LoadingScreenCVars::HoldLoadingScreenAdditionalSecs : 0.0;
 
 		if (TimeLoadingScreenLastDismissed < 0.0)
 		{
 			TimeLoadingScreenLastDismissed = CurrentTime;
+			TimeLastHoldSignalUpdate = CurrentTime;
+			for (double& Duration : HoldSignalDurations)
+			{
+				Duration = 0.0;
+			}
 		}
 		const double TimeSinceScreenDismissed = CurrentTime - TimeLoadingScreenLastDismissed;
 
-		// hold for an extra X seconds, to cover up streaming
-		if ((HoldLoadingScreenAdditionalSecs > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenAdditionalSecs))
+		// Only hold a loading screen that is still up, and once the hold is released keep it released until something needs
+		// the loading screen again, otherwise streaming or async loads during gameplay would bring it back
+		if (bCanHoldLoadingScreen && LoadingScreenCVars::HoldLoadingScreenUntilReady && bCurrentlyShowingLoadingScreen && !bReadinessHoldReleased)
+		{
+			// Hold until the readiness signals say the world is presentable, bounded by the min/max hold times
+			const double HoldLoadingScreenMinSecs = LoadingScreenCVars::HoldLoadingScreenMinSecs;
+			const double HoldLoadingScreenMaxSecs = FMath::Max<double>(LoadingScreenCVars::HoldLoadingScreenMaxSecs, HoldLoadingScreenMinSecs);
+
+			FString HoldReason;
+			const ELoadingScreenHoldSignal HoldSignal = GetReadinessSignalHoldingLoadingScreen(/*out*/ HoldReason);
+			HoldSignalDurations[(int32)HoldSignal] += CurrentTime - TimeLastHoldSignalUpdate;
+			TimeLastHoldSignalUpdate = CurrentTime;
+
+			if (TimeSinceScreenDismissed < HoldLoadingScreenMinSecs)
+			{
+				DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for at least %.2f seconds to let the world render before checking readiness"), HoldLoadingScreenMinSecs);
+				bWantToForceShowLoadingScreen = true;
+			}
+			else if ((HoldSignal != ELoadingScreenHoldSignal::None) && (TimeSinceScreenDismissed < HoldLoadingScreenMaxSecs))
+			{
+				DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up (%.2f of at most %.2f seconds): %s"), TimeSinceScreenDismissed, HoldLoadingScreenMaxSecs, *HoldReason);
+				bWantToForceShowLoadingScreen = true;
+			}
+			else
+			{
+				if (HoldSignal != ELoadingScreenHoldSignal::None)
+				{
+					UE_LOG(LogLoadingScreen, Warning, TEXT("Dropping loading screen after the max hold time of %.2f seconds, still waiting on: %s"), HoldLoadingScreenMaxSecs, *HoldReason);
+				}
+				bReadinessHoldReleased = true;
+			}
+		}
+		else if (!LoadingScreenCVars::HoldLoadingScreenUntilReady)
+		{
+			const double HoldLoadingScreenAdditionalSecs = bCanHoldLoadingScreen ? LoadingScreenCVars::HoldLoadingScreenAdditionalSecs : 0.0;
+
+			// hold for an extra X seconds, to cover up streaming
+			if ((HoldLoadingScreenAdditionalSecs > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenAdditionalSecs))
+			{
+				DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+				bWantToForceShowLoadingScreen = true;
+			}
+		}
+
+		if (bWantToForceShowLoadingScreen)
 		{
 			// Make sure we're rendering the world at this point, so that textures will actually stream in
 			//@TODO: If bNeedToShowLoadingScreen bounces back true during this window, we won't turn this off again...
 			UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
 			GameViewportClient->bDisableWorldRendering = false;
-
-			DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
-			bWantToForceShowLoadingScreen = true;
 		}
 	}
 
 	return bNeedToShowLoadingScreen || bWantToForceShowLoadingScreen;
 }
 
+ELoadingScreenHoldSignal ULoadingScreenManager::GetReadinessSignalHoldingLoadingScreen(FString& OutReason) const
+{
+	// Texture streaming: wait until (almost) nothing is still waiting on mips
+	if (IStreamingManager::Get().IsTextureStreamingEnabled())
+	{
+		const int32 NumWantingTextures = IStreamingManager::Get().GetNumWantingResources();
+		if (NumWantingTextures > LoadingScreenCVars::HoldLoadingScreenMaxWantingTextures)
+		{
+			OutReason = FString::Printf(TEXT("%d textures still waiting on streamed mips (threshold %d)"), NumWantingTextures, LoadingScreenCVars::HoldLoadingScreenMaxWantingTextures);
+			return ELoadingScreenHoldSignal::TextureStreaming;
+		}
+	}
+
+	// Shader compilation: the PSO precompile queue (and in the editor, the shader compile queue) should be empty
+	const uint32 NumPrecompilesRemaining = FShaderPipelineCache::NumPrecompilesRemaining();
+	if (NumPrecompilesRemaining > 0)
+	{
+		OutReason = FString::Printf(TEXT("%u pipeline state objects still precompiling"), NumPrecompilesRemaining);
+		return ELoadingScreenHoldSignal::ShaderCompilation;
+	}
+
+#if WITH_EDITOR
+	if (GShaderCompilingManager != nullptr)
+	{
+		const int32 NumShaderJobsRemaining = GShaderCompilingManager->GetNumRemainingJobs();
+		if (NumShaderJobsRemaining > 0)
+		{
+			OutReason = FString::Printf(TEXT("%d shader compile jobs outstanding"), NumShaderJobsRemaining);
+			return ELoadingScreenHoldSignal::ShaderCompilation;
+		}
+	}
+#endif
+
+	// Async loading: anything preloaded for the experience (or otherwise requested) should have finished loading
+	const int32 NumAsyncPackages = GetNumAsyncPackages();
+	if (NumAsyncPackages > 0)
+	{
+		OutReason = FString::Printf(TEXT("%d packages still async loading"), NumAsyncPackages);
+		return ELoadingScreenHoldSignal::AsyncLoading;
+	}
+
+	OutReason = TEXT("(everything is ready)");
+	return ELoadingScreenHoldSignal::None;
+}
+
+void ULoadingScreenManager::ReportLoadingScreenHold()
+{
+	if (TimeLoadingScreenLastDismissed < 0.0)
+	{
+		LastLoadingScreenHoldReport.Reset();
+		return;
+	}
+
+	const double TotalHoldTime = FPlatformTime::Seconds() - TimeLoadingScreenLastDismissed;
+	const double TextureStreamingTime = HoldSignalDurations[(int32)ELoadingScreenHoldSignal::TextureStreaming];
+	const double ShaderCompilationTime = HoldSignalDurations[(int32)ELoadingScreenHoldSignal::ShaderCompilation];
+	const double AsyncLoadingTime = HoldSignalDurations[(int32)ELoadingScreenHoldSignal::AsyncLoading];
+
+	LastLoadingScreenHoldReport = FString::Printf(TEXT("Held for %.2fs after loading finished (texture streaming %.2fs, shader compilation %.2fs, async loading %.2fs)"),
+		TotalHoldTime, TextureStreamingTime, ShaderCompilationTime, AsyncLoadingTime);
+
+	UE_LOG(LogLoadingScreen, Log, TEXT("LoadingScreen %s"), *LastLoadingScreenHoldReport);
+
+	CSV_CUSTOM_STAT(LoadingScreen, HoldTime, (float)TotalHoldTime, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(LoadingScreen, HoldTime_TextureStreaming, (float)TextureStreamingTime, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(LoadingScreen, HoldTime_ShaderCompilation, (float)ShaderCompilationTime, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(LoadingScreen, HoldTime_AsyncLoading, (float)AsyncLoadingTime, ECsvCustomStatOp::Set);
+}
+
 bool ULoadingScreenManager::IsShowingInitialLoadingScreen() const
 {
 	FPreLoadScreenManager* PreLoadScreenManager = FPreLoadScreenManager::Get();
@@ -489,6 +645,9 @@ void ULoadingScreenManager::ShowLoadingScreen()
 
 	CSV_EVENT(LoadingScreen, TEXT("Show"));
 
+	// Applied for the initial loading screen too, so every load shown is measured with or without the profile
+	ApplyLoadingPerformanceProfile(/*bEnable=*/ true);
+
 	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
 
 	if (IsShowingInitialLoadingScreen())
@@ -566,9 +725,15 @@ void ULoadingScreenManager::HideLoadingScreen()
 
 	CSV_EVENT(LoadingScreen, TEXT("Hide"));
 
+	ApplyLoadingPerformanceProfile(/*bEnable=*/ false);
+
 	const double LoadingScreenDuration = FPlatformTime::Seconds() - TimeLoadingScreenShown;
 	UE_LOG(LogLoadingScreen, Log, TEXT("LoadingScreen was visible for %.2fs"), LoadingScreenDuration);
 
+	ReportLoadingPerformanceProfile(LoadingScreenDuration);
+
+	ReportLoadingScreenHold();
+
 	bCurrentlyShowingLoadingScreen = false;
 }
 
@@ -645,3 +810,97 @@ void ULoadingScreenManager::ChangePerformanceSettings(bool bEnabingLoadingScreen
 	}
 }
 
+void ULoadingScreenManager::ApplyLoadingPerformanceProfile(bool bEnable)
+{
+	if (bEnable)
+	{
+		bLoadingProfileApplied = LoadingScreenCVars::UseLoadingPerformanceProfile;
+		if (!bLoadingProfileApplied)
+		{
+			return;
+		}
+
+		const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
+
+		TMap<FName, FString> Overrides = Settings->LoadingPhaseConsoleVariables;
+		if (Settings->LoadingPhaseMaxFPS > 0.0f)
+		{
+			Overrides.Add(TEXT("t.MaxFPS"), FString::SanitizeFloat(Settings->LoadingPhaseMaxFPS));
+		}
+
+		for (const TPair<FName, FString>& Override : Overrides)
+		{
+			IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(*Override.Key.ToString());
+			if (CVar == nullptr)
+			{
+				UE_LOG(LogLoadingScreen, Warning, TEXT("Loading performance profile references unknown console variable %s"), *Override.Key.ToString());
+				continue;
+			}
+
+			// Only override defaults and values from ini files, nothing sets those again at runtime so restoring them is
+			// exact.  Scalability, game settings, device profiles, hotfixes, the console, etc... could, so leave those alone.
+			const uint32 SetBy = CVar->GetFlags() & ECVF_SetByMask;
+			if ((SetBy != ECVF_SetByConstructor) && (SetBy != ECVF_SetByProjectSetting) && (SetBy != ECVF_SetBySystemSettingsIni))
+			{
+				UE_LOG(LogLoadingScreen, Verbose, TEXT("Not overriding %s for loading, it was set by something that may set it again"), *Override.Key.ToString());
+				continue;
+			}
+
+			FLoadingProfileSavedConsoleVariable& Saved = LoadingProfileSavedConsoleVariables.Add(Override.Key);
+			Saved.Value = CVar->GetString();
+			Saved.SetBy = SetBy;
+
+			CVar->Set(*Override.Value, ECVF_SetByCode);
+
+			// Read back rather than keeping Override.Value, so the comparison on restore isn't thrown off by formatting
+			Saved.AppliedValue = CVar->GetString();
+		}
+	}
+	else
+	{
+		for (const TPair<FName, FLoadingProfileSavedConsoleVariable>& SavedPair : LoadingProfileSavedConsoleVariables)
+		{
+			const FLoadingProfileSavedConsoleVariable& Saved = SavedPair.Value;
+			if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(*SavedPair.Key.ToString()))
+			{
+				// Leave it alone if something else (e.g., the console) changed it while the loading screen was up
+				const uint32 CurrentSetBy = CVar->GetFlags() & ECVF_SetByMask;
+				if ((CurrentSetBy == ECVF_SetByCode) && (CVar->GetString() == Saved.AppliedValue))
+				{
+					// Drop back to the original priority too, otherwise the variable stays at SetByCode and lower priority
+					// writes (scalability, device profiles, hotfixes) would be ignored from now on
+					const EConsoleVariableFlags SetBy = (EConsoleVariableFlags)Saved.SetBy;
+					CVar->SetFlags((EConsoleVariableFlags)((CVar->GetFlags() & ~ECVF_SetByMask) | SetBy));
+					CVar->Set(*Saved.Value, SetBy);
+				}
+				else
+				{
+					UE_LOG(LogLoadingScreen, Verbose, TEXT("Not restoring %s after loading, it was changed while the loading screen was up"), *SavedPair.Key.ToString());
+				}
+			}
+		}
+		LoadingProfileSavedConsoleVariables.Reset();
+	}
+}
+
+void ULoadingScreenManager::ReportLoadingPerformanceProfile(double LoadingScreenDuration)
+{
+	const int32 ProfileIndex = bLoadingProfileApplied ? 1 : 0;
+	LoadingScreenTotalDurations[ProfileIndex] += LoadingScreenDuration;
+	LoadingScreenCounts[ProfileIndex]++;
+
+	CSV_CUSTOM_STAT(LoadingScreen, VisibleTime, (float)LoadingScreenDuration, ECsvCustomStatOp::Set);
+
+	if ((LoadingScreenCounts[0] > 0) && (LoadingScreenCounts[1] > 0))
+	{
+		const double AverageDefault = LoadingScreenTotalDurations[0] / LoadingScreenCounts[0];
+		const double AverageProfile = LoadingScreenTotalDurations[1] / LoadingScreenCounts[1];
+		UE_LOG(LogLoadingScreen, Log, TEXT("Loading performance profile: average load %.2fs over %d loads vs. %.2fs over %d loads without it (%.2fs saved per load)"),
+			AverageProfile, LoadingScreenCounts[1], AverageDefault, LoadingScreenCounts[0], AverageDefault - AverageProfile);
+	}
+	else
+	{
+		UE_LOG(LogLoadingScreen, Log, TEXT("Loading performance profile was %s for this load (toggle CommonLoadingScreen.UseLoadingPerformanceProfile to compare against the default)"),
+			bLoadingProfileApplied ? TEXT("enabled") : TEXT("disabled"));
+	}
+}
@@ -21,6 +21,30 @@ class UWorld;
 struct FFrame;
 struct FWorldContext;
 
+/** Readiness signals that can keep the loading screen up after nothing else needs it anymore */
+enum class ELoadingScreenHoldSignal : uint8
+{
+	None,
+	TextureStreaming,
+	ShaderCompilation,
+	AsyncLoading,
+
+	MAX
+};
+
+/** A console variable overridden by the loading performance profile, and what's needed to put it back */
+struct FLoadingProfileSavedConsoleVariable
+{
+	/** The value before the override */
+	FString Value;
+
+	/** The priority (ECVF_SetBy*) the value was set with */
+	uint32 SetBy = 0;
+
+	/** The value the profile set, the variable is only restored if it still has it */
+	FString AppliedValue;
+};
+
 /**
  * Handles showing/hiding the loading screen
  */
@@ -50,6 +74,13 @@ public:
 		return DebugReasonForShowingOrHidingLoadingScreen;
 	}
 
+	/** Returns a summary of how long the last loading screen was held up after loading finished, and by which readiness signal */
+	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
+	FString GetLastLoadingScreenHoldReport() const
+	{
+		return LastLoadingScreenHoldReport;
+	}
+
 	/** Returns True when the loading screen is currently being shown */
 	bool GetLoadingScreenDisplayStatus() const
 	{
@@ -76,6 +107,12 @@ private:
 	/** Returns true if we want to be showing the loading screen (if we need to or are artificially forcing it on for other reasons). */
 	UE_API bool ShouldShowLoadingScreen();
 
+	/** Returns the first readiness signal (texture streaming, shaders, async loading) that isn't ready yet, or None */
+	UE_API ELoadingScreenHoldSignal GetReadinessSignalHoldingLoadingScreen(FString& OutReason) const;
+
+	/** Logs and records how long the loading screen was held up by each readiness signal */
+	UE_API void ReportLoadingScreenHold();
+
 	/** Returns true if we are in the initial loading flow before this screen should be used */
 	UE_API bool IsShowingInitialLoadingScreen() const;
 
@@ -96,6 +133,12 @@ private:
 
 	UE_API void ChangePerformanceSettings(bool bEnabingLoadingScreen);
 
+	/** Applies (or restores) the loading-phase console variable overrides and frame rate cap */
+	UE_API void ApplyLoadingPerformanceProfile(bool bEnable);
+
+	/** Records how long the loading screen was up and logs how that compares between loads with and without the performance profile */
+	UE_API void ReportLoadingPerformanceProfile(double LoadingScreenDuration);
+
 private:
 	/** Delegate broadcast when the loading screen visibility changes */
 	FOnLoadingScreenVisibilityChangedDelegate LoadingScreenVisibilityChanged;
@@ -118,6 +161,28 @@ private:
 	/** The time the loading screen most recently wanted to be dismissed (might still be up due to a min display duration requirement) **/
 	double TimeLoadingScreenLastDismissed = -1.0;
 
+	/** The last time the per-signal hold durations were accumulated */
+	double TimeLastHoldSignalUpdate = 0.0;
+
+	/** True once the readiness hold let the loading screen go, until something needs to show it again */
+	bool bReadinessHoldReleased = false;
+
+	/** How long each readiness signal has held the loading screen up since it was last dismissed */
+	double HoldSignalDurations[(int32)ELoadingScreenHoldSignal::MAX] = {};
+
+	/** Summary of the last loading screen hold, see GetLastLoadingScreenHoldReport */
+	FString LastLoadingScreenHoldReport;
+
+	/** The console variables overridden by the loading performance profile, to restore on hide */
+	TMap<FName, FLoadingProfileSavedConsoleVariable> LoadingProfileSavedConsoleVariables;
+
+	/** True if the loading performance profile was applied for the current (or most recent) loading screen */
+	bool bLoadingProfileApplied = false;
+
+	/** Total loading screen time and number of loads, with ([1]) and without ([0]) the loading performance profile */
+	double LoadingScreenTotalDurations[2] = { 0.0, 0.0 };
+	int32 LoadingScreenCounts[2] = { 0, 0 };
+
 	/** The time until the next log for why the loading screen is still up */
 	double TimeUntilNextLogHeartbeatSeconds = 0.0;
 
@@ -4,6 +4,7 @@
 #include "AssetRegistry/AssetData.h"
 #include "CommonUserTypes.h"
 #include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
@@ -14,6 +15,7 @@
 #include "OnlineSessionSettings.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CommonSessionSubsystem)
 
@@ -37,15 +39,138 @@ DEFINE_LOG_CATEGORY(LogCommonSession);
 
 #define LOCTEXT_NAMESPACE "CommonUser"
 
+namespace CommonSessionCVars
+{
+	static int32 NumFakeSearchResults = 0;
+	static FAutoConsoleVariableRef CVarNumFakeSearchResults(
+		TEXT("CommonSession.NumFakeSearchResults"),
+		NumFakeSearchResults,
+		TEXT("Adds this many fake sessions with varying ping and player counts to OSSv1 search results, for testing the server browser and quick play selection against the Null OSS"),
+		ECVF_Cheat);
+
+	static int32 SearchResultPingBucketMs = 50;
+	static FAutoConsoleVariableRef CVarSearchResultPingBucketMs(
+		TEXT("CommonSession.SearchResultPingBucketMs"),
+		SearchResultPingBucketMs,
+		TEXT("Ping changes within a bucket of this many milliseconds don't count as a change to a search result, so results aren't reported as changed on every refresh because of ping jitter"),
+		ECVF_Default);
+
+	/** Returns the ping quantized to SearchResultPingBucketMs, for change hashes */
+	inline int32 GetPingBucket(int32 PingInMs)
+	{
+		return (SearchResultPingBucketMs > 0) ? (PingInMs / SearchResultPingBucketMs) : PingInMs;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 //UCommonSession_SearchSessionRequest
 
 void UCommonSession_SearchSessionRequest::NotifySearchFinished(bool bSucceeded, const FText& ErrorMessage)
 {
+	// Failed searches clear the results, listeners need to hear about the removals too. Searches that were aborted
+	// before they got any results have nothing new to report
+	if (bResultsUpdated)
+	{
+		bResultsUpdated = false;
+		OnSearchResultsChanged.Broadcast(ToRawPtrTArrayUnsafe(AddedResults), ToRawPtrTArrayUnsafe(RemovedResults), ToRawPtrTArrayUnsafe(ChangedResults));
+		K2_OnSearchResultsChanged.Broadcast(ToRawPtrTArrayUnsafe(AddedResults), ToRawPtrTArrayUnsafe(RemovedResults), ToRawPtrTArrayUnsafe(ChangedResults));
+	}
+
 	OnSearchFinished.Broadcast(bSucceeded, ErrorMessage);
 	K2_OnSearchFinished.Broadcast(bSucceeded, ErrorMessage);
 }
 
+void UCommonSession_SearchSessionRequest::BeginResultsUpdate()
+{
+	PreviousResultsByKey.Reset();
+	ReusedResults.Reset();
+	AddedResults.Reset();
+	RemovedResults.Reset();
+	ChangedResults.Reset();
+
+	for (UCommonSession_SearchResult* Result : Results)
+	{
+		const FString SessionKey = Result->GetSessionKey();
+		if (PreviousResultsByKey.Contains(SessionKey))
+		{
+			// Sessions we can't tell apart are never updated in place
+			RemovedResults.Add(Result);
+		}
+		else
+		{
+			PreviousResultsByKey.Add(SessionKey, Result);
+		}
+	}
+
+	Results.Reset();
+}
+
+UCommonSession_SearchResult* UCommonSession_SearchSessionRequest::AddResult(const FString& SessionKey)
+{
+	UCommonSession_SearchResult* Result = nullptr;
+
+	TObjectPtr<UCommonSession_SearchResult> PreviousResult;
+	if (PreviousResultsByKey.RemoveAndCopyValue(SessionKey, PreviousResult))
+	{
+		Result = PreviousResult;
+		ReusedResults.Add(Result);
+	}
+	else if (ResultPool.Num() > 0)
+	{
+		Result = ResultPool.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Result = NewObject<UCommonSession_SearchResult>(this);
+	}
+
+	Results.Add(Result);
+	return Result;
+}
+
+void UCommonSession_SearchSessionRequest::EndResultsUpdate()
+{
+	for (UCommonSession_SearchResult* Result : Results)
+	{
+		const uint32 ChangeHash = Result->ComputeChangeHash();
+		if (!ReusedResults.Contains(Result))
+		{
+			AddedResults.Add(Result);
+		}
+		else if (ChangeHash != Result->LastChangeHash)
+		{
+			ChangedResults.Add(Result);
+		}
+		Result->LastChangeHash = ChangeHash;
+	}
+
+	for (const TPair<FString, TObjectPtr<UCommonSession_SearchResult>>& Pair : PreviousResultsByKey)
+	{
+		RemovedResults.Add(Pair.Value);
+	}
+
+	// Removed results keep their data until they are recycled so listeners can still look at them
+	ResultPool.Append(RemovedResults);
+
+	PreviousResultsByKey.Reset();
+	ReusedResults.Reset();
+	bResultsUpdated = true;
+}
+
+void UCommonSession_SearchSessionRequest::CopyResultsFrom(TArray<TObjectPtr<UCommonSession_SearchResult>> SourceResults)
+{
+	BeginResultsUpdate();
+	for (const UCommonSession_SearchResult* SourceResult : SourceResults)
+	{
+		UCommonSession_SearchResult* Result = AddResult(SourceResult->GetSessionKey());
+		if (Result != SourceResult)
+		{
+			Result->CopyResultFrom(*SourceResult);
+		}
+	}
+	EndResultsUpdate();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 //UCommonSession_SearchResult
@@ -85,6 +210,41 @@ int32 UCommonSession_SearchResult::GetPingInMs() const
 {
 	return Result.PingInMs;
 }
+
+FString UCommonSession_SearchResult::GetSessionKey() const
+{
+	if (Result.IsValid())
+	{
+		return Result.GetSessionIdStr();
+	}
+
+	// Fake or otherwise incomplete results, the best we can do is the owner
+	return Result.Session.OwningUserName;
+}
+
+uint32 UCommonSession_SearchResult::ComputeChangeHash() const
+{
+	uint32 Hash = GetTypeHash(CommonSessionCVars::GetPingBucket(Result.PingInMs));
+	Hash = HashCombine(Hash, GetTypeHash(Result.Session.NumOpenPublicConnections));
+	Hash = HashCombine(Hash, GetTypeHash(Result.Session.NumOpenPrivateConnections));
+	Hash = HashCombine(Hash, GetTypeHash(Result.Session.SessionSettings.NumPublicConnections));
+
+	// Map order isn't stable across searches, hash the settings in key order
+	TArray<FName, TInlineAllocator<16>> SettingKeys;
+	Result.Session.SessionSettings.Settings.GenerateKeyArray(SettingKeys);
+	SettingKeys.Sort(FNameLexicalLess());
+	for (const FName& SettingKey : SettingKeys)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(SettingKey));
+		Hash = HashCombine(Hash, GetTypeHash(Result.Session.SessionSettings.Settings[SettingKey].Data.ToString()));
+	}
+	return Hash;
+}
+
+void UCommonSession_SearchResult::CopyResultFrom(const UCommonSession_SearchResult& Other)
+{
+	Result = Other.Result;
+}
 #else
 FString UCommonSession_SearchResult::GetDescription() const
 {
@@ -138,6 +298,61 @@ int32 UCommonSession_SearchResult::GetPingInMs() const
 	// TODO:  Not a property of lobbies.  Need to implement with sessions.
 	return 0;
 }
+
+FString UCommonSession_SearchResult::GetSessionKey() const
+{
+	if (Lobby.IsValid())
+	{
+		return ToLogString(Lobby->LobbyId);
+	}
+	return ToLogString(SessionID);
+}
+
+uint32 UCommonSession_SearchResult::ComputeChangeHash() const
+{
+	if (!Lobby.IsValid())
+	{
+		return 0;
+	}
+
+	uint32 Hash = GetTypeHash(Lobby->Members.Num());
+	Hash = HashCombine(Hash, GetTypeHash(Lobby->MaxMembers));
+	Hash = HashCombine(Hash, GetTypeHash(Lobby->OwnerAccountId));
+
+	// Map order isn't stable across searches, hash the attributes in key order
+	TArray<FSchemaAttributeId, TInlineAllocator<16>> AttributeKeys;
+	Lobby->Attributes.GenerateKeyArray(AttributeKeys);
+	AttributeKeys.Sort(FNameLexicalLess());
+	for (const FSchemaAttributeId& AttributeKey : AttributeKeys)
+	{
+		const FSchemaVariant& AttributeValue = Lobby->Attributes[AttributeKey];
+		Hash = HashCombine(Hash, GetTypeHash(AttributeKey));
+		switch (AttributeValue.GetType())
+		{
+		case ESchemaAttributeType::Bool:
+			Hash = HashCombine(Hash, GetTypeHash(AttributeValue.GetBoolean()));
+			break;
+		case ESchemaAttributeType::Int64:
+			Hash = HashCombine(Hash, GetTypeHash(AttributeValue.GetInt64()));
+			break;
+		case ESchemaAttributeType::Double:
+			Hash = HashCombine(Hash, GetTypeHash(AttributeValue.GetDouble()));
+			break;
+		case ESchemaAttributeType::String:
+			Hash = HashCombine(Hash, GetTypeHash(AttributeValue.GetString()));
+			break;
+		default:
+			break;
+		}
+	}
+	return Hash;
+}
+
+void UCommonSession_SearchResult::CopyResultFrom(const UCommonSession_SearchResult& Other)
+{
+	Lobby = Other.Lobby;
+	SessionID = Other.SessionID;
+}
 #endif //COMMONUSER_OSSV1
 
 
@@ -162,6 +377,12 @@ public:
 		return NameString;
 	}
 
+	/** Describes everything this search asks the online service for, searches with the same key get the same results */
+	virtual FString GetQueryKey() const
+	{
+		return FString::Printf(TEXT("Mode=%d|Lobbies=%d"), (int32)SearchRequest->OnlineMode, SearchRequest->bUseLobbies ? 1 : 0);
+	}
+
 public:
 	TObjectPtr<UCommonSession_SearchSessionRequest> SearchRequest = nullptr;
 };
@@ -216,6 +437,19 @@ public:
 	}
 
 	virtual ~FCommonOnlineSearchSettingsOSSv1() {}
+
+	virtual FString GetQueryKey() const override
+	{
+		// Sorted, so the order the query settings were added in (or are stored in) doesn't matter
+		TArray<FString> Params;
+		for (const TPair<FName, FOnlineSessionSearchParam>& Param : QuerySettings.SearchParams)
+		{
+			Params.Add(FString::Printf(TEXT("%s %d %s"), *Param.Key.ToString(), (int32)Param.Value.ComparisonOp, *Param.Value.Data.ToString()));
+		}
+		Params.Sort();
+
+		return FString::Printf(TEXT("%s|Lan=%d|Max=%d|%s"), *FCommonOnlineSearchSettingsBase::GetQueryKey(), bIsLanQuery ? 1 : 0, MaxSearchResults, *FString::Join(Params, TEXT(";")));
+	}
 };
 #else
 
@@ -229,6 +463,20 @@ public:
 
 		FindLobbyParams.Filters.Emplace(FFindLobbySearchFilter{ SETTING_ONLINESUBSYSTEM_VERSION, ESchemaAttributeComparisonOp::Equals, true });
 	}
+
+	virtual FString GetQueryKey() const override
+	{
+		// Sorted, so the order the filters were added in doesn't matter
+		TArray<FString> Filters;
+		for (const FFindLobbySearchFilter& Filter : FindLobbyParams.Filters)
+		{
+			Filters.Add(FString::Printf(TEXT("%s %d %s"), *Filter.AttributeName.ToString(), (int32)Filter.ComparisonOp, *ToLogString(Filter.ComparisonValue)));
+		}
+		Filters.Sort();
+
+		return FString::Printf(TEXT("%s|Max=%d|%s"), *FCommonOnlineSearchSettingsBase::GetQueryKey(), (int32)FindLobbyParams.MaxResults, *FString::Join(Filters, TEXT(";")));
+	}
+
 public:
 	FFindLobbies::Params FindLobbyParams;
 };
@@ -770,15 +1018,6 @@ void UCommonSessionSubsystem::FindSessions(APlayerController* SearchingPlayer, U
 
 void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings)
 {
-	if (SearchSettings.IsValid())
-	{
-		//@TODO: This is a poor user experience for the API user, we should let the additional search piggyback and
-		// just give it the same results as the currently pending one
-		// (or enqueue the request and service it when the previous one finishes or fails)
-		UE_LOG(LogCommonSession, Error, TEXT("A previous FindSessions call is still in progress, aborting"));
-		SearchSettings->SearchRequest->NotifySearchFinished(false, LOCTEXT("Error_FindSessionAlreadyInProgress", "Session search already in progress"));
-	}
-
 	ULocalPlayer* LocalPlayer = (SearchingPlayer != nullptr) ? SearchingPlayer->GetLocalPlayer() : nullptr;
 	if (LocalPlayer == nullptr)
 	{
@@ -787,7 +1026,21 @@ void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingP
 		return;
 	}
 
+	const FString QueryKey = GetSearchQueryKey(*InSearchSettings);
+
+	// Repeated searches (e.g., the front end refreshing) don't need to hit the online service again
+	if (TryFindSessionsFromCache(InSearchSettings->SearchRequest, QueryKey))
+	{
+		return;
+	}
+
+	if (TryPiggybackOnPendingSearch(InSearchSettings->SearchRequest, QueryKey))
+	{
+		return;
+	}
+
 	SearchSettings = InSearchSettings;
+	SearchQueryKey = QueryKey;
 #if COMMONUSER_OSSV1
 	FindSessionsInternalOSSv1(LocalPlayer);
 #else
@@ -837,7 +1090,7 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv2(ULocalPlayer* LocalPlaye
 		if (bWasSuccessful)
 		{
 			const FFindLobbies::Result& FindResults = FindResult.GetOkValue();
-			SearchSettings->SearchRequest->Results.Reset(FindResults.Lobbies.Num());
+			SearchSettings->SearchRequest->BeginResultsUpdate();
 
 			for (const TSharedRef<const FLobby>& Lobby : FindResults.Lobbies)
 			{
@@ -853,24 +1106,24 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv2(ULocalPlayer* LocalPlaye
 				}
 				else
 				{
-					UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettings->SearchRequest);
+					UCommonSession_SearchResult* Entry = SearchSettings->SearchRequest->AddResult(ToLogString(Lobby->LobbyId));
 					Entry->Lobby = Lobby;
-					SearchSettings->SearchRequest->Results.Add(Entry);
 
 					UE_LOG(LogCommonSession, Log, TEXT("\tFound lobby (UserId: %s, NumOpenConns: %d)"),
 						*ToLogString(Lobby->OwnerAccountId), Lobby->MaxMembers - Lobby->Members.Num());
 				}
 			}
+			SearchSettings->SearchRequest->EndResultsUpdate();
 		}
 		else
 		{
-			SearchSettings->SearchRequest->Results.Empty();
+			SearchSettings->SearchRequest->BeginResultsUpdate();
+			SearchSettings->SearchRequest->EndResultsUpdate();
 		}
 
 		const FText ResultText = bWasSuccessful ? FText() : FindResult.GetErrorValue().GetText();
 
-		SearchSettings->SearchRequest->NotifySearchFinished(bWasSuccessful, ResultText);
-		SearchSettings.Reset();
+		FinishSessionSearch(bWasSuccessful, ResultText);
 	});
 }
 #endif // COMMONUSER_OSSV1
@@ -889,7 +1142,7 @@ void UCommonSessionSubsystem::QuickPlaySession(APlayerController* JoiningOrHosti
 	TWeakObjectPtr<APlayerController> JoiningOrHostingPlayerPtr = TWeakObjectPtr<APlayerController>(JoiningOrHostingPlayer);
 
 	UCommonSession_SearchSessionRequest* QuickPlayRequest = CreateOnlineSearchSessionRequest();
-	QuickPlayRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleQuickPlaySearchFinished, JoiningOrHostingPlayerPtr, HostRequestPtr);
+	QuickPlayRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleQuickPlaySearchFinished, MakeWeakObjectPtr(QuickPlayRequest), JoiningOrHostingPlayerPtr, HostRequestPtr);
 
 	// We enable presence by default on the primary session used for matchmaking. For online systems that care about presence, only the primary session should have presence enabled
 
@@ -954,24 +1207,35 @@ TSharedRef<FCommonOnlineSearchSettings> UCommonSessionSubsystem::CreateQuickPlay
 
 #endif // COMMONUSER_OSSV1
 
-void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
+void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<UCommonSession_SearchSessionRequest> QuickPlayRequest, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
 {
-	const int32 ResultCount = SearchSettings->SearchRequest->Results.Num();
+	const int32 ResultCount = QuickPlayRequest.IsValid() ? QuickPlayRequest->Results.Num() : 0;
 	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay Search Finished %s (Results %d) (Error: %s)"), bSucceeded ? TEXT("Success") : TEXT("Failed"), ResultCount, *ErrorMessage.ToString());
 
 	//@TODO: We have to check if the error message is empty because some OSS layers report a failure just because there are no sessions.  Please fix with OSS 2.0.
 	if (bSucceeded || ErrorMessage.IsEmpty())
 	{
 		// Join the best search result.
-		if (ResultCount > 0)
+		UCommonSession_SearchResult* BestResult = nullptr;
+		float BestScore = 0.0f;
+		for (int32 ResultIndex = 0; ResultIndex < ResultCount; ResultIndex++)
 		{
-			//@TODO: We should probably look at ping?  maybe some other factors to find the best.  Idk if they come pre-sorted or not.
-			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
+			UCommonSession_SearchResult* Result = QuickPlayRequest->Results[ResultIndex];
+			const float Score = ScoreQuickPlaySearchResult(Result, HostRequest.Get());
+			UE_LOG(LogCommonSession, Verbose, TEXT("\tQuickPlay candidate %s (Ping: %d ms, Score: %.1f)"), *Result->GetDescription(), Result->GetPingInMs(), Score);
+
+			if ((Score >= 0.0f) && ((BestResult == nullptr) || (Score > BestScore)))
 			{
-				JoinSession(JoiningOrHostingPlayer.Get(), Result);
-				return;
+				BestResult = Result;
+				BestScore = Score;
 			}
 		}
+
+		if (BestResult != nullptr)
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("QuickPlay joining %s (Ping: %d ms, Score: %.1f)"), *BestResult->GetDescription(), BestResult->GetPingInMs(), BestScore);
+			JoinSession(JoiningOrHostingPlayer.Get(), BestResult);
+		}
 		else
 		{
 			HostSession(JoiningOrHostingPlayer.Get(), HostRequest.Get());
@@ -984,10 +1248,172 @@ void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, con
 	}
 }
 
+float UCommonSessionSubsystem::ScoreQuickPlaySearchResult(const UCommonSession_SearchResult* SearchResult, const UCommonSession_HostSessionRequest* HostRequest) const
+{
+	const int32 PingInMs = SearchResult->GetPingInMs();
+	if ((PingInMs >= MAX_QUERY_PING) || (PingInMs > QuickPlayMaxPingMs))
+	{
+		return -1.0f;
+	}
+
+	const int32 OpenConnections = SearchResult->GetNumOpenPublicConnections();
+	const int32 MaxConnections = SearchResult->GetMaxPublicConnections();
+	if (OpenConnections <= 0)
+	{
+		return -1.0f;
+	}
+
+	float Score = 1000.0f - (PingInMs * QuickPlayPingWeight);
+
+	if (MaxConnections > 0)
+	{
+		const float Occupancy = FMath::Clamp((float)(MaxConnections - OpenConnections) / (float)MaxConnections, 0.0f, 1.0f);
+		Score += Occupancy * QuickPlayOccupancyWeight;
+	}
+
+	if (!QuickPlayPreferredRegion.IsEmpty())
+	{
+		FString Region;
+		bool bFoundRegion = false;
+		SearchResult->GetStringSetting(QuickPlayRegionSettingKey, Region, bFoundRegion);
+		if (bFoundRegion && Region.Equals(QuickPlayPreferredRegion, ESearchCase::IgnoreCase))
+		{
+			Score += QuickPlayRegionMatchWeight;
+		}
+	}
+
+	return FMath::Max(Score, 0.0f);
+}
+
+FString UCommonSessionSubsystem::GetSearchQueryKey(const FCommonOnlineSearchSettings& InSearchSettings)
+{
+	return InSearchSettings.GetQueryKey();
+}
+
+bool UCommonSessionSubsystem::CanShareSearchResults(const FString& QueryKeyA, const FString& QueryKeyB) const
+{
+	// Only identical queries, a search filtered on a mode or map must never be answered with another search's results
+	return !QueryKeyA.IsEmpty() && QueryKeyA.Equals(QueryKeyB, ESearchCase::CaseSensitive);
+}
+
+void UCommonSessionSubsystem::FinishSessionSearch(bool bSucceeded, const FText& ErrorMessage)
+{
+	check(SearchSettings.IsValid());
+	UCommonSession_SearchSessionRequest* FinishedRequest = SearchSettings->SearchRequest;
+
+	// Reset the search state before notifying anyone, listeners often start a new search right away
+	TSharedPtr<FCommonOnlineSearchSettings> FinishedSearchSettings = MoveTemp(SearchSettings);
+	FString FinishedSearchQueryKey = MoveTemp(SearchQueryKey);
+	SearchQueryKey.Reset();
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> PiggybackedRequests = MoveTemp(PiggybackedSearchRequests);
+
+	if (bSucceeded && (SearchResultCacheDuration > 0.0f))
+	{
+		CachedSearchQueryKey = MoveTemp(FinishedSearchQueryKey);
+		CachedSearchResults = FinishedRequest->Results;
+		CachedSearchResultsTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		InvalidateSearchResultCache();
+	}
+
+	FinishedRequest->NotifySearchFinished(bSucceeded, ErrorMessage);
+
+	for (UCommonSession_SearchSessionRequest* PiggybackedRequest : PiggybackedRequests)
+	{
+		PiggybackedRequest->CopyResultsFrom(FinishedRequest->Results);
+		PiggybackedRequest->NotifySearchFinished(bSucceeded, ErrorMessage);
+	}
+}
+
+bool UCommonSessionSubsystem::TryPiggybackOnPendingSearch(UCommonSession_SearchSessionRequest* Request, const FString& QueryKey)
+{
+	if (!SearchSettings.IsValid())
+	{
+		return false;
+	}
+
+	if (CanShareSearchResults(SearchQueryKey, QueryKey))
+	{
+		// Piggyback on the pending search, we'll get the same results when it finishes
+		UE_LOG(LogCommonSession, Log, TEXT("A previous FindSessions call is still in progress, waiting for its results"));
+		PiggybackedSearchRequests.AddUnique(Request);
+		return true;
+	}
+
+	// The pending search is looking for something else, abandon it
+	UE_LOG(LogCommonSession, Error, TEXT("A previous incompatible FindSessions call is still in progress, aborting it"));
+	const FText AbortedText = LOCTEXT("Error_FindSessionAlreadyInProgress", "Session search already in progress");
+
+	UCommonSession_SearchSessionRequest* AbortedSearchRequest = SearchSettings->SearchRequest;
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> AbortedRequests = MoveTemp(PiggybackedSearchRequests);
+	SearchSettings.Reset();
+	SearchQueryKey.Reset();
+
+	AbortedSearchRequest->NotifySearchFinished(false, AbortedText);
+	for (UCommonSession_SearchSessionRequest* AbortedRequest : AbortedRequests)
+	{
+		AbortedRequest->NotifySearchFinished(false, AbortedText);
+	}
+
+	return false;
+}
+
+bool UCommonSessionSubsystem::CanUseSearchResultCache(const FString& QueryKey, double CurrentTime)
+{
+	if ((CachedSearchResultsTime < 0.0) || (SearchResultCacheDuration <= 0.0f))
+	{
+		return false;
+	}
+
+	if ((CurrentTime - CachedSearchResultsTime) > SearchResultCacheDuration)
+	{
+		InvalidateSearchResultCache();
+		return false;
+	}
+
+	return CanShareSearchResults(CachedSearchQueryKey, QueryKey);
+}
+
+bool UCommonSessionSubsystem::TryFindSessionsFromCache(UCommonSession_SearchSessionRequest* Request, const FString& QueryKey)
+{
+	if (!CanUseSearchResultCache(QueryKey, FPlatformTime::Seconds()))
+	{
+		return false;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("FindSessions using %d cached results from %.2fs ago"), CachedSearchResults.Num(), FPlatformTime::Seconds() - CachedSearchResultsTime);
+
+	Request->CopyResultsFrom(CachedSearchResults);
+
+	// Notify next tick so the caller gets the same ordering of events as a real search
+	PendingCachedSearchRequests.Add(Request);
+	GetGameInstance()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UCommonSessionSubsystem::HandleCachedSearchFinished, MakeWeakObjectPtr(Request)));
+	return true;
+}
+
+void UCommonSessionSubsystem::HandleCachedSearchFinished(TWeakObjectPtr<UCommonSession_SearchSessionRequest> Request)
+{
+	if (Request.IsValid() && PendingCachedSearchRequests.RemoveSingle(Request.Get()) > 0)
+	{
+		Request->NotifySearchFinished(true, FText());
+	}
+}
+
+void UCommonSessionSubsystem::InvalidateSearchResultCache()
+{
+	CachedSearchQueryKey.Reset();
+	CachedSearchResults.Reset();
+	CachedSearchResultsTime = -1.0;
+}
+
 void UCommonSessionSubsystem::CleanUpSessions()
 {
 	bWantToDestroyPendingSession = true;
 
+	StopPreloadingSessionMap();
+
 	if (bUseBeacons)
 	{
 		DestroyHostReservationBeacon();
@@ -1093,17 +1519,16 @@ void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
 		return;
 	}
 
+	SearchSettingsV1.SearchRequest->BeginResultsUpdate();
+
 	if (bWasSuccessful)
 	{
-		SearchSettingsV1.SearchRequest->Results.Reset(SearchSettingsV1.SearchResults.Num());
-
 		for (const FOnlineSessionSearchResult& Result : SearchSettingsV1.SearchResults)
 		{
 			check(Result.IsValid());
 
-			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettingsV1.SearchRequest);
+			UCommonSession_SearchResult* Entry = SearchSettingsV1.SearchRequest->AddResult(Result.GetSessionIdStr());
 			Entry->Result = Result;
-			SearchSettingsV1.SearchRequest->Results.Add(Entry);
 
 			FString SessionId = TEXT("Unknown");
 			if (Result.Session.SessionInfo.IsValid())
@@ -1127,30 +1552,28 @@ void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
 				);
 		}
 	}
-	else
-	{
-		SearchSettingsV1.SearchRequest->Results.Empty();
-	}
 
-	if (0)
+	if (CommonSessionCVars::NumFakeSearchResults > 0)
 	{
 		// Fake Sessions OSSV1
-		for (int i = 0; i < 10; i++)
+		for (int32 i = 0; i < CommonSessionCVars::NumFakeSearchResults; i++)
 		{
-			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettings->SearchRequest);
 			FOnlineSessionSearchResult FakeResult;
-			FakeResult.Session.OwningUserName = TEXT("Fake User");
+			FakeResult.Session.OwningUserName = FString::Printf(TEXT("Fake User %d"), i);
 			FakeResult.Session.SessionSettings.NumPublicConnections = 10;
+			FakeResult.Session.NumOpenPublicConnections = (i * 3) % 11;
 			FakeResult.Session.SessionSettings.bShouldAdvertise = true;
 			FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
-			FakeResult.PingInMs=99;
+			FakeResult.PingInMs = 20 + ((i * 37) % 300);
+
+			UCommonSession_SearchResult* Entry = SearchSettingsV1.SearchRequest->AddResult(FakeResult.Session.OwningUserName);
 			Entry->Result = FakeResult;
-			SearchSettingsV1.SearchRequest->Results.Add(Entry);
 		}
 	}
+
+	SearchSettingsV1.SearchRequest->EndResultsUpdate();
 	
-	SearchSettingsV1.SearchRequest->NotifySearchFinished(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
-	SearchSettings.Reset();
+	FinishSessionSearch(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
 }
 #endif // COMMONUSER_OSSV1
 
@@ -1170,6 +1593,9 @@ void UCommonSessionSubsystem::JoinSession(APlayerController* JoiningPlayer, UCom
 		return;
 	}
 
+	// Player counts are about to change, don't hand out stale results after this
+	InvalidateSearchResultCache();
+
 	// Update presence here since we won't have the raw game mode and map name keys after client travel. If joining/travel fails, it is reset to main menu 
 	FString SessionGameMode, SessionMapName;
 	bool bEmpty;
@@ -1186,9 +1612,67 @@ void UCommonSessionSubsystem::JoinSession(APlayerController* JoiningPlayer, UCom
 	}
 #endif // COMMONUSER_OSSV1
 
+	JoinSessionStartTime = FPlatformTime::Seconds();
+
+	// The join and reservation round trips take a while, load the map in the meantime
+	if (bPreloadMapWhileJoining)
+	{
+		StartPreloadingSessionMap(SessionMapName);
+	}
+
 	JoinSessionInternal(LocalPlayer, Request);
 }
 
+void UCommonSessionSubsystem::StartPreloadingSessionMap(const FString& MapName)
+{
+	StopPreloadingSessionMap();
+
+	if (MapName.IsEmpty() || !FPackageName::IsValidLongPackageName(MapName))
+	{
+		return;
+	}
+
+	const FSoftObjectPath MapPath(FString::Printf(TEXT("%s.%s"), *MapName, *FPackageName::GetShortName(MapName)));
+	UE_LOG(LogCommonSession, Log, TEXT("Preloading %s while joining the session"), *MapPath.ToString());
+
+	SessionMapPreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MapPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("CommonSessionMapPreload"));
+}
+
+void UCommonSessionSubsystem::StopPreloadingSessionMap()
+{
+	if (SessionMapPreloadHandle.IsValid())
+	{
+		SessionMapPreloadHandle->ReleaseHandle();
+		SessionMapPreloadHandle.Reset();
+	}
+}
+
+void UCommonSessionSubsystem::FailJoinSession(const FOnlineResultInformation& JoinSessionResult)
+{
+	// With a pipelined reservation both halves can fail, only report it once
+	if (bJoinSessionFailed)
+	{
+		return;
+	}
+	bJoinSessionFailed = true;
+
+	StopPreloadingSessionMap();
+
+	NotifyJoinSessionComplete(JoinSessionResult);
+	NotifySessionInformationUpdated(ECommonSessionInformationState::OutOfGame);
+
+	if (bJoinSessionInFlight)
+	{
+		// A pipelined reservation failed before the online join completed, destroying the session now would race
+		// the join. FinishJoinSession cleans up once it arrives
+		UE_LOG(LogCommonSession, Log, TEXT("Join failed while the session join is still in progress, cleaning up once it completes"));
+		return;
+	}
+
+	// If the session join failed, we'll clean up the session
+	CleanUpSessions();
+}
+
 void UCommonSessionSubsystem::JoinSessionInternal(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request)
 {
 #if COMMONUSER_OSSV1
@@ -1210,6 +1694,25 @@ void UCommonSessionSubsystem::JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer
 	Request->Result.Session.SessionSettings.bUsesPresence = true;
 	Request->Result.Session.SessionSettings.bUseLobbiesIfAvailable = bUseLobbiesDefault;
 
+	bJoinReservationPipelined = false;
+	bJoinSessionSucceeded = false;
+	bJoinReservationAccepted = false;
+	bJoinSessionFailed = false;
+	bJoinSessionInFlight = true;
+
+	// If the beacon address can be resolved from the search result, ask for the reservation while the session join is in flight.
+	// This has to happen first as some OSSes complete the join inside JoinSession.
+	if (bUseBeacons && bPipelineJoinReservation)
+	{
+		FString ConnectInfo;
+		if (Sessions->GetResolvedConnectString(Request->Result, NAME_BeaconPort, ConnectInfo))
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("Requesting reservation alongside the session join"));
+			bJoinReservationPipelined = true;
+			RequestHostReservation(ConnectInfo, Request->Result.GetSessionIdStr());
+		}
+	}
+
 	Sessions->JoinSession(*LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId(), NAME_GameSession, Request->Result);
 }
 
@@ -1239,12 +1742,7 @@ void UCommonSessionSubsystem::OnRegisterJoiningLocalPlayerComplete(const FUnique
 
 void UCommonSessionSubsystem::ConnectToHostReservationBeacon()
 {
-	UWorld* const World = GetWorld();
-	check(World);
-	ReservationBeaconClient = World->SpawnActor<APartyBeaconClient>(APartyBeaconClient::StaticClass());
-	check(ReservationBeaconClient.IsValid());
-
-	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(World);
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
 	check(OnlineSub);
 	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
 	check(Sessions);
@@ -1255,6 +1753,19 @@ void UCommonSessionSubsystem::ConnectToHostReservationBeacon()
 	FString ConnectInfo;
 	Sessions->GetResolvedConnectString(NAME_GameSession, ConnectInfo, NAME_BeaconPort);
 
+	RequestHostReservation(ConnectInfo, SessionIdStr);
+}
+
+void UCommonSessionSubsystem::RequestHostReservation(const FString& ConnectInfo, const FString& SessionIdStr)
+{
+	UWorld* const World = GetWorld();
+	check(World);
+	ReservationBeaconClient = World->SpawnActor<APartyBeaconClient>(APartyBeaconClient::StaticClass());
+	check(ReservationBeaconClient.IsValid());
+
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(World);
+	check(OnlineSub);
+
 	IOnlineIdentityPtr Identity = OnlineSub->GetIdentityInterface();
 	check(Identity);
 	FUniqueNetIdWrapper DefaultNetId = Identity->GetUniquePlayerId(0);
@@ -1273,10 +1784,7 @@ void UCommonSessionSubsystem::ConnectToHostReservationBeacon()
 				JoinSessionResult.bWasSuccessful = false;
 				JoinSessionResult.ErrorId = TEXT("UnknownError");
 
-				NotifyJoinSessionComplete(JoinSessionResult);
-				NotifySessionInformationUpdated(ECommonSessionInformationState::OutOfGame);
-
-				CleanUpSessions();
+				FailJoinSession(JoinSessionResult);
 			}
 		});
 
@@ -1284,11 +1792,13 @@ void UCommonSessionSubsystem::ConnectToHostReservationBeacon()
 		{
 			if (ReservationResponse == EPartyReservationResult::ReservationAccepted)
 			{
-				FOnlineResultInformation JoinSessionResult;
-				JoinSessionResult.bWasSuccessful = true;
-				NotifyJoinSessionComplete(JoinSessionResult);
+				bJoinReservationAccepted = true;
 
-				InternalTravelToSession(NAME_GameSession);
+				// A pipelined reservation can beat the session join, in which case FinishJoinSession completes the join
+				if (!bJoinReservationPipelined || bJoinSessionSucceeded)
+				{
+					CompleteJoinSession();
+				}
 			}
 			else
 			{
@@ -1296,33 +1806,62 @@ void UCommonSessionSubsystem::ConnectToHostReservationBeacon()
 				JoinSessionResult.bWasSuccessful = false;
 				JoinSessionResult.ErrorId = TEXT("UnknownError");
 
-				NotifyJoinSessionComplete(JoinSessionResult);
-				NotifySessionInformationUpdated(ECommonSessionInformationState::OutOfGame);
-
-				CleanUpSessions();
+				FailJoinSession(JoinSessionResult);
 			}
 		});
 
 	ReservationBeaconClient->RequestReservation(ConnectInfo, SessionIdStr, *DefaultNetId, { PlayerReservation });
 }
 
+void UCommonSessionSubsystem::CompleteJoinSession()
+{
+	if (bJoinSessionFailed)
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("Session join and reservation completed in %.2fs%s"), FPlatformTime::Seconds() - JoinSessionStartTime, bJoinReservationPipelined ? TEXT(" (pipelined)") : TEXT(""));
+
+	//@TODO Synchronize timing of this with create callbacks, modify both places and the comments if plan changes
+	FOnlineResultInformation JoinSessionResult;
+	JoinSessionResult.bWasSuccessful = true;
+	NotifyJoinSessionComplete(JoinSessionResult);
+
+	InternalTravelToSession(NAME_GameSession);
+}
+
 void UCommonSessionSubsystem::FinishJoinSession(EOnJoinSessionCompleteResult::Type Result)
 {
+	bJoinSessionInFlight = false;
+
+	if (bJoinSessionFailed)
+	{
+		// The pipelined reservation already failed and was reported, the session can be cleaned up now the join is done
+		UE_LOG(LogCommonSession, Log, TEXT("FinishJoinSession(Result: %s) after the reservation failed, cleaning up"), LexToString(Result));
+		CleanUpSessions();
+		return;
+	}
+
 	if (Result == EOnJoinSessionCompleteResult::Success)
 	{
-		if (bUseBeacons)
+		bJoinSessionSucceeded = true;
+
+		if (bUseBeacons && bJoinReservationPipelined)
+		{
+			// The reservation was requested alongside the join, travel now if it has already been accepted
+			if (bJoinReservationAccepted)
+			{
+				CompleteJoinSession();
+			}
+		}
+		else if (bUseBeacons)
 		{
 			// InternalTravelToSession and the notification will be called by the beacon after a successful reservation. The beacon will be destroyed during travel.
 			ConnectToHostReservationBeacon();
 		}
 		else
 		{
-			//@TODO Synchronize timing of this with create callbacks, modify both places and the comments if plan changes
-			FOnlineResultInformation JoinSessionResult;
-			JoinSessionResult.bWasSuccessful = true;
-			NotifyJoinSessionComplete(JoinSessionResult);
-
-			InternalTravelToSession(NAME_GameSession);
+			CompleteJoinSession();
 		}
 	}
 	else
@@ -1349,11 +1888,7 @@ void UCommonSessionSubsystem::FinishJoinSession(EOnJoinSessionCompleteResult::Ty
 		JoinSessionResult.bWasSuccessful = false;
 		JoinSessionResult.ErrorId = LexToString(Result); // This is not robust but there is no extended information available
 		JoinSessionResult.ErrorText = ReturnReason;
-		NotifyJoinSessionComplete(JoinSessionResult);
-		NotifySessionInformationUpdated(ECommonSessionInformationState::OutOfGame);
-
-		// If the session join failed, we'll clean up the session
-		CleanUpSessions();
+		FailJoinSession(JoinSessionResult);
 	}
 }
 
@@ -1365,6 +1900,8 @@ void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer
 	IOnlineServicesPtr OnlineServices = GetServices(GetWorld());
 	check(OnlineServices);
 
+	bJoinSessionFailed = false;
+
 	// If the request doesnt have a lobby assume it's a session
 	if (!Request->Lobby.IsValid())
 	{
@@ -1388,8 +1925,11 @@ void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer
 				}
 				else
 				{
-					//@TODO: Error handling
-					UE_LOG(LogCommonSession, Error, TEXT("JoinLobby Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
+					UE_LOG(LogCommonSession, Error, TEXT("JoinSession Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
+
+					FOnlineResultInformation JoinSessionResult;
+					JoinSessionResult.FromOnlineError(JoinResult.GetErrorValue());
+					FailJoinSession(JoinSessionResult);
 				}
 			});
 	}
@@ -1417,8 +1957,11 @@ void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer
 		 		}
 		 		else
 		 		{
-		 			//@TODO: Error handling
 		 			UE_LOG(LogCommonSession, Error, TEXT("JoinLobby Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
+
+		 			FOnlineResultInformation JoinSessionResult;
+		 			JoinSessionResult.FromOnlineError(JoinResult.GetErrorValue());
+		 			FailJoinSession(JoinSessionResult);
 		 		}
 		 	});
 	}
@@ -1713,6 +2256,8 @@ void UCommonSessionSubsystem::TravelLocalSessionFailure(UWorld* World, ETravelFa
 		ETravelFailure::ToString(FailureType),
 		*ReasonString);
 
+	StopPreloadingSessionMap();
+
 	// TODO:  Broadcast this failure when we are also able to broadcast a success. Presently we broadcast a success before starting the travel, so a failure after a success is confusing.
 	//FOnlineResultInformation JoinSessionResult;
 	//JoinSessionResult.bWasSuccessful = false;
@@ -1742,6 +2287,9 @@ void UCommonSessionSubsystem::HandlePostLoadMap(UWorld* World)
 		return;
 	}
 
+	// The preloaded map (if any) has been used or is no longer wanted now that we've arrived somewhere
+	StopPreloadingSessionMap();
+
 #if COMMONUSER_OSSV1
 	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
 	check(OnlineSub);
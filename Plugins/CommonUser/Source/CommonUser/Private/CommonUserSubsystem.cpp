@@ -3,10 +3,16 @@
 #include "CommonUserSubsystem.h"
 #include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
+#include "HAL/FileManager.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
 #include "InputKeyEventArgs.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "NativeGameplayTags.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CommonUserSubsystem)
@@ -75,6 +81,7 @@ void UCommonUserInfo::UpdateCachedPrivilegeResult(ECommonUserPrivilege Privilege
 
 	// Update direct cache first
 	ContextCache->CachedPrivileges.Add(Privilege, Result);
+	ContextCache->PrivilegesToRevalidate.Remove(Privilege);
 
 	if (GameCache != ContextCache)
 	{
@@ -106,6 +113,11 @@ void UCommonUserInfo::UpdateCachedPrivilegeResult(ECommonUserPrivilege Privilege
 
 		GameCache->CachedPrivileges.Add(Privilege, GameContextResult);
 	}
+
+	if (UCommonUserSubsystem* Subsystem = GetSubsystem())
+	{
+		Subsystem->UpdatePersistedUserCache(this, Context);
+	}
 }
 
 void UCommonUserInfo::UpdateCachedNetId(const FUniqueNetIdRepl& NewId, ECommonUserOnlineContext Context)
@@ -137,6 +149,12 @@ void UCommonUserInfo::UpdateCachedNetId(const FUniqueNetIdRepl& NewId, ECommonUs
 	}
 
 	// We don't merge the ids because of how guests work
+
+	if (UCommonUserSubsystem* Subsystem = GetSubsystem())
+	{
+		Subsystem->ApplyPersistedUserCache(this, Context);
+		Subsystem->RefreshUserInfoLookups();
+	}
 }
 
 class UCommonUserSubsystem* UCommonUserInfo::GetSubsystem() const
@@ -337,6 +355,12 @@ void UCommonUserSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Matches the engine default
 	SetMaxLocalPlayers(4);
 
+	if (bPersistUserCache)
+	{
+		// Needs to be loaded before the first user is refreshed
+		LoadPersistedUserCache();
+	}
+
 	ResetUserState();
 
 	UGameInstance* GameInstance = GetGameInstance();
@@ -384,12 +408,19 @@ void UCommonUserSubsystem::CreateOnlineContexts()
 
 void UCommonUserSubsystem::Deinitialize()
 {
+	if (bPersistedUserCacheSaveQueued)
+	{
+		SavePersistedUserCache();
+	}
+
 	DestroyOnlineContexts();
 
 	IPlatformInputDeviceMapper& DeviceMapper = IPlatformInputDeviceMapper::Get();
 	DeviceMapper.GetOnInputDeviceConnectionChange().RemoveAll(this);
 
 	LocalUserInfos.Reset();
+	UserInfosByPlatformUser.Reset();
+	UserInfosByNetId.Reset();
 	ActiveLoginRequests.Reset();
 
 	Super::Deinitialize();
@@ -434,6 +465,7 @@ UCommonUserInfo* UCommonUserSubsystem::CreateLocalUserInfo(int32 LocalPlayerInde
 		}
 
 		LocalUserInfos.Add(LocalPlayerIndex, NewUser);
+		RefreshUserInfoLookups();
 	}
 	return NewUser;
 }
@@ -1212,6 +1244,7 @@ bool UCommonUserSubsystem::TryToLogOutUser(int32 LocalPlayerIndex, bool bDestroy
 		UE_LOG(LogCommonUser, Log, TEXT("TryToLogOutUser succeeded for guest player index %d"), LocalPlayerIndex);
 
 		LocalUserInfos.Remove(LocalPlayerIndex);
+		RefreshUserInfoLookups();
 	}
 
 	if (bDestroyPlayer)
@@ -1239,6 +1272,7 @@ void UCommonUserSubsystem::ResetUserState()
 	}
 
 	LocalUserInfos.Reset();
+	RefreshUserInfoLookups();
 
 	// Cancel in-progress logins
 	ActiveLoginRequests.Reset();
@@ -1378,6 +1412,9 @@ void UCommonUserSubsystem::HandleLoginForUserInitialize(const UCommonUserInfo* U
 		LocalUserInfo->bIsGuest = false;
 	}
 
+	// Guests are not included in the platform user lookup
+	RefreshUserInfoLookups();
+
 	ensure(LocalUserInfo->IsDoingLogin());
 
 	if (Error.IsSet())
@@ -1496,6 +1533,7 @@ bool UCommonUserSubsystem::LoginLocalUser(const UCommonUserInfo* UserInfo, EComm
 	}
 
 	TSharedRef<FUserLoginRequest> NewRequest = MakeShared<FUserLoginRequest>(LocalUserInfo, RequestedPrivilege, Context, MoveTemp(OnComplete));
+	NewRequest->StageStartTimes[(int32)ELoginStage::Total] = FPlatformTime::Seconds();
 	ActiveLoginRequests.Add(NewRequest);
 
 	// This will execute callback or start login process
@@ -1517,6 +1555,9 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 		return;
 	}
 
+	// Handlers always reprocess after changing a stage state, so this catches every stage that finished
+	UpdateLoginStageLatencies(Request);
+
 	const FPlatformUserId PlatformUser = UserInfo->GetPlatformUserId();
 
 	// If the platform user id is invalid because this is a guest, skip right to failure
@@ -1589,6 +1630,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 		if (Request->TransferPlatformAuthState == ECommonUserAsyncTaskState::NotStarted)
 		{
 			Request->TransferPlatformAuthState = ECommonUserAsyncTaskState::InProgress;
+			BeginLoginStage(Request, ELoginStage::TransferPlatformAuth);
 
 			if (TransferPlatformAuth(System, Request, PlatformUser))
 			{
@@ -1596,6 +1638,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 			}
 			// We didn't start a login attempt, so set failure
 			Request->TransferPlatformAuthState = ECommonUserAsyncTaskState::Failed;
+			Request->StageStartTimes[(int32)ELoginStage::TransferPlatformAuth] = 0.0;
 		}
 
 		// Next check AutoLogin
@@ -1604,6 +1647,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 			if (Request->TransferPlatformAuthState == ECommonUserAsyncTaskState::Done || Request->TransferPlatformAuthState == ECommonUserAsyncTaskState::Failed)
 			{
 				Request->AutoLoginState = ECommonUserAsyncTaskState::InProgress;
+				BeginLoginStage(Request, ELoginStage::AutoLogin);
 
 				// Try an auto login with default credentials, this will work on many platforms
 				if (AutoLogin(System, Request, PlatformUser))
@@ -1612,6 +1656,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 				}
 				// We didn't start an autologin attempt, so set failure
 				Request->AutoLoginState = ECommonUserAsyncTaskState::Failed;
+				Request->StageStartTimes[(int32)ELoginStage::AutoLogin] = 0.0;
 			}
 		}
 
@@ -1622,6 +1667,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 				&& (Request->AutoLoginState == ECommonUserAsyncTaskState::Done || Request->AutoLoginState == ECommonUserAsyncTaskState::Failed))
 			{
 				Request->LoginUIState = ECommonUserAsyncTaskState::InProgress;
+				BeginLoginStage(Request, ELoginStage::LoginUI);
 
 				if (ShowLoginUI(System, Request, PlatformUser))
 				{
@@ -1629,6 +1675,7 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 				}
 				// We didn't show a UI, so set failure
 				Request->LoginUIState = ECommonUserAsyncTaskState::Failed;
+				Request->StageStartTimes[(int32)ELoginStage::LoginUI] = 0.0;
 			}
 		}
 	}
@@ -1661,9 +1708,46 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 			{
 				// Use cached success value
 				Request->PrivilegeCheckState = ECommonUserAsyncTaskState::Done;
+
+				// If that came from the persisted cache, check it again in the background without holding up the request.
+				// No request will be waiting on the result, but it updates the cache and broadcasts if availability changed
+				UCommonUserInfo::FCachedData* ContextCache = UserInfo->GetCachedData(Request->CurrentContext);
+				if (ContextCache && ContextCache->PrivilegesToRevalidate.Remove(Request->DesiredPrivilege) > 0)
+				{
+					UE_LOG(LogCommonUser, Verbose, TEXT("Revalidating persisted privilege %d for UserIdx:%d, Context:%s"), (int32)Request->DesiredPrivilege, UserInfo->GetPlatformUserIndex(), *ECommonUserOnlineContextToString(Request->CurrentContext));
+					QueryUserPrivilege(System, Request, PlatformUser);
+				}
+			}
+			else if (bParallelizeLoginContexts && Request->CurrentContext != ResolveOnlineContext(Request->DesiredContext))
+			{
+				// Don't wait on the check for this context, start logging into the next context while it runs.
+				// It gets joined again before the request completes
+				const ECommonUserOnlineContext CheckContext = Request->CurrentContext;
+				Request->PendingPrivilegeChecks.Add(CheckContext, ECommonUserAsyncTaskState::InProgress);
+				Request->PendingPrivilegeCheckStartTimes.Add(CheckContext, FPlatformTime::Seconds());
+				Request->PrivilegeCheckState = ECommonUserAsyncTaskState::Done;
+
+				if (!QueryUserPrivilege(System, Request, PlatformUser))
+				{
+#if COMMONUSER_OSSV1
+					Request->PendingPrivilegeChecks.Add(CheckContext, ECommonUserAsyncTaskState::Failed);
+#else
+					// Temp while OSSv2 gets privileges implemented
+					Request->PendingPrivilegeChecks.Remove(CheckContext);
+#endif
+					Request->PendingPrivilegeCheckStartTimes.Remove(CheckContext);
+				}
+
+				// The query may have completed immediately and already moved this request along
+				if (Request->CurrentContext != CheckContext || !ActiveLoginRequests.Contains(Request))
+				{
+					return;
+				}
 			}
 			else
 			{
+				BeginLoginStage(Request, ELoginStage::PrivilegeCheck);
+
 				if (QueryUserPrivilege(System, Request, PlatformUser))
 				{
 					return;
@@ -1711,12 +1795,42 @@ void UCommonUserSubsystem::ProcessLoginRequest(TSharedRef<FUserLoginRequest> Req
 		return;
 	}
 
+	// Join any privilege checks that were left running for earlier contexts
+	if (Request->OverallLoginState == ECommonUserAsyncTaskState::Done)
+	{
+		const ECommonUserAsyncTaskState PendingChecksState = GetPendingPrivilegeChecksState(*Request);
+		if (PendingChecksState == ECommonUserAsyncTaskState::InProgress)
+		{
+			// Stall to wait for all of them to finish
+			return;
+		}
+		else if (PendingChecksState == ECommonUserAsyncTaskState::Failed)
+		{
+			// Count a privilege failure in any context as a login failure
+			Request->OverallLoginState = ECommonUserAsyncTaskState::Failed;
+		}
+	}
+
 	// If done, remove and do callback
 	if (Request->OverallLoginState == ECommonUserAsyncTaskState::Done || Request->OverallLoginState == ECommonUserAsyncTaskState::Failed)
 	{
 		// Skip if this already happened in a nested function
 		if (ActiveLoginRequests.Contains(Request))
 		{
+			const double RequestStartTime = Request->StageStartTimes[(int32)ELoginStage::Total];
+			if (RequestStartTime > 0.0)
+			{
+				UE_LOG(LogCommonUser, Log, TEXT("Login request finished in %.1f ms - UserIdx:%d, Context:%s, Privilege:%d, Successful:%d"),
+					(FPlatformTime::Seconds() - RequestStartTime) * 1000.0,
+					UserInfo->GetPlatformUserIndex(),
+					*ECommonUserOnlineContextToString(Request->DesiredContext),
+					(int32)Request->DesiredPrivilege,
+					(int32)(Request->OverallLoginState == ECommonUserAsyncTaskState::Done));
+
+				RecordLoginStageLatency(ELoginStage::Total, RequestStartTime, Request->DesiredContext);
+				Request->StageStartTimes[(int32)ELoginStage::Total] = 0.0;
+			}
+
 			// Add a generic error if none is set
 			if (Request->OverallLoginState == ECommonUserAsyncTaskState::Failed && !Request->Error.IsSet())
 			{
@@ -1810,6 +1924,7 @@ void UCommonUserSubsystem::HandleOnLoginUIClosed(TSharedPtr<const FUniqueNetId>
 				if (UserInfo->PlatformUser != PlatformUser && PlatformUser != PLATFORMUSERID_NONE)
 				{
 					UserInfo->PlatformUser = PlatformUser;
+					RefreshUserInfoLookups();
 				}
 
 				Request->LoginUIState = ECommonUserAsyncTaskState::Done;
@@ -1875,6 +1990,15 @@ void UCommonUserSubsystem::HandleCheckPrivilegesComplete(const FUniqueNetId& Use
 				Request->Error = FOnlineError(FText::Format(NSLOCTEXT("CommonUser", "PrivilegeFailureFormat", "{0} to {1}"), GetPrivilegeResultDescription(UserResult), GetPrivilegeDescription(UserPrivilege)));
 			}
 
+			ProcessLoginRequest(Request);
+		}
+		else if (Request->UserInfo.Get() == UserInfo && Request->DesiredPrivilege == UserPrivilege && CompletePendingPrivilegeCheck(Request, Context, UserResult == ECommonUserPrivilegeResult::Available))
+		{
+			if (UserResult != ECommonUserPrivilegeResult::Available)
+			{
+				Request->Error = FOnlineError(FText::Format(NSLOCTEXT("CommonUser", "PrivilegeFailureFormat", "{0} to {1}"), GetPrivilegeResultDescription(UserResult), GetPrivilegeDescription(UserPrivilege)));
+			}
+
 			ProcessLoginRequest(Request);
 		}
 	}
@@ -1960,6 +2084,7 @@ void UCommonUserSubsystem::HandleOnLoginUIClosedV2(const UE::Online::TOnlineResu
 				if (UserInfo->PlatformUser != PlatformUser && PlatformUser != PLATFORMUSERID_NONE)
 				{
 					UserInfo->PlatformUser = PlatformUser;
+					RefreshUserInfoLookups();
 				}
 
 				Request->LoginUIState = ECommonUserAsyncTaskState::Done;
@@ -2015,12 +2140,141 @@ void UCommonUserSubsystem::HandleCheckPrivilegesComplete(const UE::Online::TOnli
 				Request->Error = Result.IsError() ? Result.GetErrorValue() : UE::Online::Errors::Unknown();
 			}
 
+			ProcessLoginRequest(Request);
+		}
+		else if (Request->UserInfo.Get() == UserInfo && Request->DesiredPrivilege == UserPrivilege && CompletePendingPrivilegeCheck(Request, Context, UserResult == ECommonUserPrivilegeResult::Available))
+		{
+			if (UserResult != ECommonUserPrivilegeResult::Available)
+			{
+				Request->Error = Result.IsError() ? Result.GetErrorValue() : UE::Online::Errors::Unknown();
+			}
+
 			ProcessLoginRequest(Request);
 		}
 	}
 }
 #endif // COMMONUSER_OSSV1
 
+void UCommonUserSubsystem::BeginLoginStage(TSharedRef<FUserLoginRequest> Request, ELoginStage Stage)
+{
+	Request->StageStartTimes[(int32)Stage] = FPlatformTime::Seconds();
+}
+
+void UCommonUserSubsystem::UpdateLoginStageLatencies(TSharedRef<FUserLoginRequest> Request)
+{
+	const ECommonUserAsyncTaskState StageStates[] =
+	{
+		Request->TransferPlatformAuthState,
+		Request->AutoLoginState,
+		Request->LoginUIState,
+		Request->PrivilegeCheckState
+	};
+
+	for (int32 StageIndex = 0; StageIndex < UE_ARRAY_COUNT(StageStates); StageIndex++)
+	{
+		double& StartTime = Request->StageStartTimes[StageIndex];
+		if (StartTime > 0.0 && StageStates[StageIndex] != ECommonUserAsyncTaskState::InProgress)
+		{
+			RecordLoginStageLatency((ELoginStage)StageIndex, StartTime, Request->CurrentContext);
+			StartTime = 0.0;
+		}
+	}
+}
+
+void UCommonUserSubsystem::RecordLoginStageLatency(ELoginStage Stage, double StartTime, ECommonUserOnlineContext Context)
+{
+	const double DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	LoginStageLatencies[(int32)Stage].AddSample(DurationMs);
+
+	UE_LOG(LogCommonUser, Verbose, TEXT("Login stage %d took %.1f ms - Context:%s"), (int32)Stage, DurationMs, *ECommonUserOnlineContextToString(Context));
+}
+
+bool UCommonUserSubsystem::CompletePendingPrivilegeCheck(TSharedRef<FUserLoginRequest> Request, ECommonUserOnlineContext Context, bool bWasSuccessful)
+{
+	ECommonUserAsyncTaskState* PendingState = Request->PendingPrivilegeChecks.Find(Context);
+	if (!PendingState || *PendingState != ECommonUserAsyncTaskState::InProgress)
+	{
+		return false;
+	}
+
+	*PendingState = bWasSuccessful ? ECommonUserAsyncTaskState::Done : ECommonUserAsyncTaskState::Failed;
+
+	double StartTime = 0.0;
+	if (Request->PendingPrivilegeCheckStartTimes.RemoveAndCopyValue(Context, StartTime))
+	{
+		RecordLoginStageLatency(ELoginStage::PrivilegeCheck, StartTime, Context);
+	}
+
+	return true;
+}
+
+ECommonUserAsyncTaskState UCommonUserSubsystem::GetPendingPrivilegeChecksState(const FUserLoginRequest& Request) const
+{
+	ECommonUserAsyncTaskState Result = ECommonUserAsyncTaskState::Done;
+	for (const TPair<ECommonUserOnlineContext, ECommonUserAsyncTaskState>& Pair : Request.PendingPrivilegeChecks)
+	{
+		if (Pair.Value == ECommonUserAsyncTaskState::InProgress)
+		{
+			return ECommonUserAsyncTaskState::InProgress;
+		}
+		else if (Pair.Value == ECommonUserAsyncTaskState::Failed)
+		{
+			Result = ECommonUserAsyncTaskState::Failed;
+		}
+	}
+
+	return Result;
+}
+
+void UCommonUserSubsystem::FLoginLatencyHistogram::AddSample(double DurationMs)
+{
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && DurationMs > BucketLimitsMs[BucketIndex])
+	{
+		BucketIndex++;
+	}
+
+	BucketCounts[BucketIndex]++;
+	NumSamples++;
+	TotalMs += DurationMs;
+	MaxMs = FMath::Max(MaxMs, DurationMs);
+}
+
+FString UCommonUserSubsystem::FLoginLatencyHistogram::ToString() const
+{
+	if (NumSamples == 0)
+	{
+		return TEXT("no samples");
+	}
+
+	FString Result = FString::Printf(TEXT("n=%d avg=%.1fms max=%.1fms |"), NumSamples, TotalMs / NumSamples, MaxMs);
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; BucketIndex++)
+	{
+		if (BucketIndex < NumBuckets - 1)
+		{
+			Result += FString::Printf(TEXT(" <=%.0f:%d"), BucketLimitsMs[BucketIndex], BucketCounts[BucketIndex]);
+		}
+		else
+		{
+			Result += FString::Printf(TEXT(" >%.0f:%d"), BucketLimitsMs[BucketIndex - 1], BucketCounts[BucketIndex]);
+		}
+	}
+	return Result;
+}
+
+FString UCommonUserSubsystem::GetLoginLatencyReport() const
+{
+	static const TCHAR* StageNames[] = { TEXT("TransferPlatformAuth"), TEXT("AutoLogin"), TEXT("LoginUI"), TEXT("PrivilegeCheck"), TEXT("Total") };
+	static_assert(UE_ARRAY_COUNT(StageNames) == (int32)ELoginStage::Count, "StageNames must match ELoginStage");
+
+	FString Report;
+	for (int32 StageIndex = 0; StageIndex < (int32)ELoginStage::Count; StageIndex++)
+	{
+		Report += FString::Printf(TEXT("%s: %s\n"), StageNames[StageIndex], *LoginStageLatencies[StageIndex].ToString());
+	}
+	return Report;
+}
+
 void UCommonUserSubsystem::RefreshLocalUserInfo(UCommonUserInfo* UserInfo)
 {
 	if (ensure(UserInfo))
@@ -2399,6 +2653,206 @@ void UCommonUserSubsystem::SetLocalPlayerUserInfo(ULocalPlayer* LocalPlayer, con
 		{
 			PlayerController->PlayerState->SetUniqueId(NetId);
 		}
+
+		RefreshUserInfoLookups();
+	}
+}
+
+namespace CommonUserPersistedCache
+{
+	/** Starts the persisted user cache file, followed by the version, payload size and payload CRC */
+	static constexpr uint32 FileMagic = 0x43555543;
+
+	/** Bump when the format of the cache entries changes, files with another version are thrown away */
+	static constexpr int32 FileVersion = 1;
+}
+
+FString UCommonUserSubsystem::GetPersistedUserCachePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("CommonUser") / TEXT("UserCache.bin");
+}
+
+void UCommonUserSubsystem::LoadPersistedUserCache()
+{
+	PersistedUserCache.Reset();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *GetPersistedUserCachePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 PayloadSize = 0;
+	uint32 PayloadCrc = 0;
+	Reader << Magic << Version << PayloadSize << PayloadCrc;
+
+	// Only deserialize a payload that is complete and was written by this version, a truncated, corrupt or older file
+	// could otherwise turn into garbage entries or huge allocations
+	const int64 HeaderSize = Reader.Tell();
+	const bool bValidHeader = !Reader.IsError() && Magic == CommonUserPersistedCache::FileMagic && Version == CommonUserPersistedCache::FileVersion;
+	if (!bValidHeader || PayloadSize != FileData.Num() - HeaderSize || FCrc::MemCrc32(FileData.GetData() + HeaderSize, PayloadSize) != PayloadCrc)
+	{
+		UE_LOG(LogCommonUser, Warning, TEXT("LoadPersistedUserCache found an invalid or outdated %s, deleting it"), *GetPersistedUserCachePath());
+		IFileManager::Get().Delete(*GetPersistedUserCachePath());
+		return;
+	}
+
+	Reader << PersistedUserCache;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogCommonUser, Warning, TEXT("LoadPersistedUserCache failed to read %s, ignoring it"), *GetPersistedUserCachePath());
+		PersistedUserCache.Reset();
+		return;
+	}
+
+	const FDateTime Now = FDateTime::UtcNow();
+	for (TMap<FString, FPersistedUserCacheEntry>::TIterator It(PersistedUserCache); It; ++It)
+	{
+		if ((Now - It.Value().SavedTime).GetTotalSeconds() > PersistedUserCacheLifetime)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	UE_LOG(LogCommonUser, Log, TEXT("LoadPersistedUserCache loaded %d users"), PersistedUserCache.Num());
+}
+
+void UCommonUserSubsystem::SavePersistedUserCache()
+{
+	bPersistedUserCacheSaveQueued = false;
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << PersistedUserCache;
+
+	uint32 Magic = CommonUserPersistedCache::FileMagic;
+	int32 Version = CommonUserPersistedCache::FileVersion;
+	int32 PayloadSize = Payload.Num();
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	Writer << Magic << Version << PayloadSize << PayloadCrc;
+	Writer.Serialize(Payload.GetData(), Payload.Num());
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *GetPersistedUserCachePath()))
+	{
+		UE_LOG(LogCommonUser, Warning, TEXT("SavePersistedUserCache failed to write %s"), *GetPersistedUserCachePath());
+	}
+}
+
+void UCommonUserSubsystem::ApplyPersistedUserCache(UCommonUserInfo* UserInfo, ECommonUserOnlineContext Context)
+{
+	// Game is merged from the other contexts so it is never persisted directly
+	if (!bPersistUserCache || !UserInfo || UserInfo->bIsGuest || Context == ECommonUserOnlineContext::Game)
+	{
+		return;
+	}
+
+	UCommonUserInfo::FCachedData* ContextCache = UserInfo->GetCachedData(Context);
+	if (!ContextCache || !ContextCache->CachedNetId.IsValid())
+	{
+		return;
+	}
+
+	const FPersistedUserCacheEntry* Entry = PersistedUserCache.Find(ContextCache->CachedNetId.ToString());
+	if (!Entry || (FDateTime::UtcNow() - Entry->SavedTime).GetTotalSeconds() > PersistedUserCacheLifetime)
+	{
+		return;
+	}
+
+	if (ContextCache->CachedNickname.IsEmpty())
+	{
+		ContextCache->CachedNickname = Entry->Nickname;
+	}
+
+	TGuardValue<bool> ApplyingGuard(bApplyingPersistedUserCache, true);
+
+	for (const TPair<uint8, uint8>& Pair : Entry->PrivilegeResults)
+	{
+		const ECommonUserPrivilege Privilege = (ECommonUserPrivilege)Pair.Key;
+
+		// Never override a result that came from the online system
+		if (Privilege < ECommonUserPrivilege::Invalid_Count && !ContextCache->CachedPrivileges.Contains(Privilege))
+		{
+			UpdateUserPrivilegeResult(UserInfo, Privilege, (ECommonUserPrivilegeResult)Pair.Value, Context);
+			ContextCache->PrivilegesToRevalidate.Add(Privilege);
+		}
+	}
+}
+
+void UCommonUserSubsystem::UpdatePersistedUserCache(UCommonUserInfo* UserInfo, ECommonUserOnlineContext Context)
+{
+	if (!bPersistUserCache || bApplyingPersistedUserCache || !UserInfo || UserInfo->bIsGuest || Context == ECommonUserOnlineContext::Game)
+	{
+		return;
+	}
+
+	const UCommonUserInfo::FCachedData* ContextCache = UserInfo->GetCachedData(Context);
+	if (!ContextCache || !ContextCache->CachedNetId.IsValid())
+	{
+		return;
+	}
+
+	FPersistedUserCacheEntry& Entry = PersistedUserCache.FindOrAdd(ContextCache->CachedNetId.ToString());
+	if (!ContextCache->CachedNickname.IsEmpty())
+	{
+		Entry.Nickname = ContextCache->CachedNickname;
+	}
+
+	Entry.PrivilegeResults.Reset();
+	for (const TPair<ECommonUserPrivilege, ECommonUserPrivilegeResult>& Pair : ContextCache->CachedPrivileges)
+	{
+		// Don't save results that have not been confirmed yet, that would extend their lifetime
+		if (Pair.Value != ECommonUserPrivilegeResult::Unknown && !ContextCache->PrivilegesToRevalidate.Contains(Pair.Key))
+		{
+			Entry.PrivilegeResults.Add((uint8)Pair.Key, (uint8)Pair.Value);
+		}
+	}
+	Entry.SavedTime = FDateTime::UtcNow();
+
+	// Coalesce all of the updates from a login into one write
+	UGameInstance* GameInstance = GetGameInstance();
+	if (!bPersistedUserCacheSaveQueued && GameInstance)
+	{
+		bPersistedUserCacheSaveQueued = true;
+		GameInstance->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::SavePersistedUserCache));
+	}
+}
+
+void UCommonUserSubsystem::RefreshUserInfoLookups()
+{
+	UserInfosByPlatformUser.Reset();
+	UserInfosByNetId.Reset();
+
+	// Earlier entries win, to match the iteration order of the old linear searches
+	for (TPair<int32, UCommonUserInfo*> Pair : LocalUserInfos)
+	{
+		UCommonUserInfo* UserInfo = Pair.Value;
+		if (!UserInfo)
+		{
+			continue;
+		}
+
+		// Don't include guest users in the platform user lookup
+		if (!UserInfo->bIsGuest && IsRealPlatformUser(UserInfo->PlatformUser) && !UserInfosByPlatformUser.Contains(UserInfo->PlatformUser))
+		{
+			UserInfosByPlatformUser.Add(UserInfo->PlatformUser, UserInfo);
+		}
+
+		for (const TPair<ECommonUserOnlineContext, UCommonUserInfo::FCachedData>& CachedPair : UserInfo->CachedDataMap)
+		{
+			const FUniqueNetIdRepl& CachedNetId = CachedPair.Value.CachedNetId;
+			if (CachedNetId.IsValid() && !UserInfosByNetId.Contains(CachedNetId))
+			{
+				UserInfosByNetId.Add(CachedNetId, UserInfo);
+			}
+		}
 	}
 }
 
@@ -2425,13 +2879,11 @@ const UCommonUserInfo* UCommonUserSubsystem::GetUserInfoForPlatformUser(FPlatfor
 		return nullptr;
 	}
 
-	for (TPair<int32, UCommonUserInfo*> Pair : LocalUserInfos)
+	// Kept up to date by RefreshUserInfoLookups, this is called from input handling so avoid searching every user
+	const TWeakObjectPtr<UCommonUserInfo>* FoundUser = UserInfosByPlatformUser.Find(PlatformUser);
+	if (FoundUser)
 	{
-		// Don't include guest users in this check
-		if (ensure(Pair.Value) && Pair.Value->PlatformUser == PlatformUser && !Pair.Value->bIsGuest)
-		{
-			return Pair.Value;
-		}
+		return FoundUser->Get();
 	}
 
 	return nullptr;
@@ -2445,18 +2897,11 @@ const UCommonUserInfo* UCommonUserSubsystem::GetUserInfoForUniqueNetId(const FUn
 		return nullptr;
 	}
 
-	for (TPair<int32, UCommonUserInfo*> UserPair : LocalUserInfos)
+	// Kept up to date by RefreshUserInfoLookups
+	const TWeakObjectPtr<UCommonUserInfo>* FoundUser = UserInfosByNetId.Find(NetId);
+	if (FoundUser)
 	{
-		if (ensure(UserPair.Value))
-		{
-			for (const TPair<ECommonUserOnlineContext, UCommonUserInfo::FCachedData>& CachedPair : UserPair.Value->CachedDataMap)
-			{
-				if (NetId == CachedPair.Value.CachedNetId)
-				{
-					return UserPair.Value;
-				}
-			}
-		}
+		return FoundUser->Get();
 	}
 
 	return nullptr;
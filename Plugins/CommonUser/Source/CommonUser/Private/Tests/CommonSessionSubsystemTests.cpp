@@ -0,0 +1,296 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonSessionSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if COMMONUSER_OSSV1
+#include "OnlineSessionSettings.h"
+#endif // COMMONUSER_OSSV1
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Gives the tests access to the search state of a session subsystem */
+struct FCommonSessionSubsystemTestAccess
+{
+	static UCommonSession_SearchSessionRequest* CreateSearchRequest(UCommonSessionSubsystem* Subsystem, ECommonSessionOnlineMode OnlineMode, bool bUseLobbies)
+	{
+		UCommonSession_SearchSessionRequest* Request = NewObject<UCommonSession_SearchSessionRequest>(Subsystem);
+		Request->OnlineMode = OnlineMode;
+		Request->bUseLobbies = bUseLobbies;
+		return Request;
+	}
+
+	static FString GetQueryKey(UCommonSessionSubsystem* Subsystem, UCommonSession_SearchSessionRequest* Request)
+	{
+		return UCommonSessionSubsystem::GetSearchQueryKey(*Subsystem->CreateQuickPlaySearchSettings(nullptr, Request));
+	}
+
+	/** Makes the request the pending search, as if it had been sent to the online service */
+	static void StartSearch(UCommonSessionSubsystem* Subsystem, UCommonSession_SearchSessionRequest* Request)
+	{
+		Subsystem->SearchSettings = Subsystem->CreateQuickPlaySearchSettings(nullptr, Request);
+		Subsystem->SearchQueryKey = UCommonSessionSubsystem::GetSearchQueryKey(*Subsystem->SearchSettings);
+	}
+
+	static bool TryPiggybackOnPendingSearch(UCommonSessionSubsystem* Subsystem, UCommonSession_SearchSessionRequest* Request)
+	{
+		return Subsystem->TryPiggybackOnPendingSearch(Request, GetQueryKey(Subsystem, Request));
+	}
+
+	static bool IsSearchPending(const UCommonSessionSubsystem* Subsystem)
+	{
+		return Subsystem->SearchSettings.IsValid();
+	}
+
+	static bool IsPiggybacking(const UCommonSessionSubsystem* Subsystem, UCommonSession_SearchSessionRequest* Request)
+	{
+		return Subsystem->PiggybackedSearchRequests.Contains(Request);
+	}
+
+	static void FinishSearch(UCommonSessionSubsystem* Subsystem, bool bSucceeded)
+	{
+		Subsystem->FinishSessionSearch(bSucceeded, FText());
+	}
+
+	static bool CanUseSearchResultCache(UCommonSessionSubsystem* Subsystem, UCommonSession_SearchSessionRequest* Request, double SecondsSinceCached)
+	{
+		return Subsystem->CanUseSearchResultCache(GetQueryKey(Subsystem, Request), Subsystem->CachedSearchResultsTime + SecondsSinceCached);
+	}
+
+	static int32 GetNumCachedSearchResults(const UCommonSessionSubsystem* Subsystem)
+	{
+		return Subsystem->CachedSearchResults.Num();
+	}
+
+	static float ScoreQuickPlaySearchResult(const UCommonSessionSubsystem* Subsystem, const UCommonSession_SearchResult* SearchResult)
+	{
+		return Subsystem->ScoreQuickPlaySearchResult(SearchResult, nullptr);
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionSearchQueryKeyTest, "CommonUser.Session.SearchQueryKey", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionSearchQueryKeyTest::RunTest(const FString& Parameters)
+{
+	UCommonSessionSubsystem* Subsystem = NewObject<UCommonSessionSubsystem>(GetTransientPackage());
+
+	const FString OnlineLobbiesKey = FCommonSessionSubsystemTestAccess::GetQueryKey(Subsystem, FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true));
+	const FString OtherOnlineLobbiesKey = FCommonSessionSubsystemTestAccess::GetQueryKey(Subsystem, FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true));
+	const FString OnlineSessionsKey = FCommonSessionSubsystemTestAccess::GetQueryKey(Subsystem, FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, false));
+	const FString LANLobbiesKey = FCommonSessionSubsystemTestAccess::GetQueryKey(Subsystem, FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::LAN, true));
+
+	TestFalse(TEXT("Query key is not empty"), OnlineLobbiesKey.IsEmpty());
+	TestEqual(TEXT("Identical searches have the same query key"), OnlineLobbiesKey, OtherOnlineLobbiesKey);
+	TestNotEqual(TEXT("Lobby and session searches have different query keys"), OnlineLobbiesKey, OnlineSessionsKey);
+	TestNotEqual(TEXT("Online and LAN searches have different query keys"), OnlineLobbiesKey, LANLobbiesKey);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionSearchPiggybackTest, "CommonUser.Session.SearchPiggyback", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionSearchPiggybackTest::RunTest(const FString& Parameters)
+{
+	UCommonSessionSubsystem* Subsystem = NewObject<UCommonSessionSubsystem>(GetTransientPackage());
+	Subsystem->SearchResultCacheDuration = 0.0f;
+
+	UCommonSession_SearchSessionRequest* PendingRequest = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true);
+	UCommonSession_SearchSessionRequest* SameRequest = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true);
+	UCommonSession_SearchSessionRequest* LANRequest = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::LAN, true);
+
+	TestFalse(TEXT("Nothing to piggyback on without a pending search"), FCommonSessionSubsystemTestAccess::TryPiggybackOnPendingSearch(Subsystem, SameRequest));
+
+	// An identical search waits for the pending one and gets its results
+	FCommonSessionSubsystemTestAccess::StartSearch(Subsystem, PendingRequest);
+	TestTrue(TEXT("Identical search piggybacks on the pending search"), FCommonSessionSubsystemTestAccess::TryPiggybackOnPendingSearch(Subsystem, SameRequest));
+	TestTrue(TEXT("Piggybacked request is tracked"), FCommonSessionSubsystemTestAccess::IsPiggybacking(Subsystem, SameRequest));
+
+	bool bSameRequestSucceeded = false;
+	SameRequest->OnSearchFinished.AddLambda([&bSameRequestSucceeded](bool bSucceeded, const FText&) { bSameRequestSucceeded = bSucceeded; });
+
+	PendingRequest->Results.Add(NewObject<UCommonSession_SearchResult>(PendingRequest));
+	PendingRequest->Results.Add(NewObject<UCommonSession_SearchResult>(PendingRequest));
+#if COMMONUSER_OSSV1
+	PendingRequest->Results[0]->Result.Session.OwningUserName = TEXT("HostA");
+	PendingRequest->Results[1]->Result.Session.OwningUserName = TEXT("HostB");
+#endif // COMMONUSER_OSSV1
+	FCommonSessionSubsystemTestAccess::FinishSearch(Subsystem, true);
+
+	TestTrue(TEXT("Piggybacked request is notified of success"), bSameRequestSucceeded);
+	TestEqual(TEXT("Piggybacked request gets the pending search's results"), SameRequest->Results.Num(), PendingRequest->Results.Num());
+	TestFalse(TEXT("No search is pending once it finished"), FCommonSessionSubsystemTestAccess::IsSearchPending(Subsystem));
+
+	// A different search must not be answered with the pending search's results, the pending search is aborted instead
+	bool bPendingRequestFinished = false;
+	bool bPendingRequestSucceeded = true;
+	PendingRequest->OnSearchFinished.Clear();
+	PendingRequest->OnSearchFinished.AddLambda([&bPendingRequestFinished, &bPendingRequestSucceeded](bool bSucceeded, const FText&) { bPendingRequestFinished = true; bPendingRequestSucceeded = bSucceeded; });
+
+	FCommonSessionSubsystemTestAccess::StartSearch(Subsystem, PendingRequest);
+	TestFalse(TEXT("Different search does not piggyback"), FCommonSessionSubsystemTestAccess::TryPiggybackOnPendingSearch(Subsystem, LANRequest));
+	TestFalse(TEXT("Different search is not tracked as piggybacked"), FCommonSessionSubsystemTestAccess::IsPiggybacking(Subsystem, LANRequest));
+	TestTrue(TEXT("Pending search is aborted"), bPendingRequestFinished && !bPendingRequestSucceeded);
+	TestFalse(TEXT("Aborted search is no longer pending"), FCommonSessionSubsystemTestAccess::IsSearchPending(Subsystem));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionSearchCacheTest, "CommonUser.Session.SearchResultCache", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionSearchCacheTest::RunTest(const FString& Parameters)
+{
+	UCommonSessionSubsystem* Subsystem = NewObject<UCommonSessionSubsystem>(GetTransientPackage());
+	Subsystem->SearchResultCacheDuration = 5.0f;
+
+	UCommonSession_SearchSessionRequest* Request = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true);
+	UCommonSession_SearchSessionRequest* SameRequest = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, true);
+	UCommonSession_SearchSessionRequest* SessionsRequest = FCommonSessionSubsystemTestAccess::CreateSearchRequest(Subsystem, ECommonSessionOnlineMode::Online, false);
+
+	TestFalse(TEXT("Nothing is cached before a search"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 0.0));
+
+	// Failed searches are never cached
+	FCommonSessionSubsystemTestAccess::StartSearch(Subsystem, Request);
+	FCommonSessionSubsystemTestAccess::FinishSearch(Subsystem, false);
+	TestFalse(TEXT("Failed search is not cached"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 0.0));
+
+	Request->Results.Add(NewObject<UCommonSession_SearchResult>(Request));
+	FCommonSessionSubsystemTestAccess::StartSearch(Subsystem, Request);
+	FCommonSessionSubsystemTestAccess::FinishSearch(Subsystem, true);
+
+	TestTrue(TEXT("Identical search uses the cache"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 1.0));
+	TestFalse(TEXT("Different search does not use the cache"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SessionsRequest, 1.0));
+	TestEqual(TEXT("Cache holds the search results"), FCommonSessionSubsystemTestAccess::GetNumCachedSearchResults(Subsystem), 1);
+
+	TestFalse(TEXT("Expired cache is not used"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 6.0));
+	TestEqual(TEXT("Expired cache is thrown away"), FCommonSessionSubsystemTestAccess::GetNumCachedSearchResults(Subsystem), 0);
+	TestFalse(TEXT("Cache stays empty after expiring"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 0.0));
+
+	// Caching can be turned off
+	Subsystem->SearchResultCacheDuration = 0.0f;
+	FCommonSessionSubsystemTestAccess::StartSearch(Subsystem, Request);
+	FCommonSessionSubsystemTestAccess::FinishSearch(Subsystem, true);
+	TestFalse(TEXT("Nothing is cached when caching is disabled"), FCommonSessionSubsystemTestAccess::CanUseSearchResultCache(Subsystem, SameRequest, 0.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionSearchResultsChangedTest, "CommonUser.Session.SearchResultsChanged", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionSearchResultsChangedTest::RunTest(const FString& Parameters)
+{
+	UCommonSession_SearchSessionRequest* Request = NewObject<UCommonSession_SearchSessionRequest>(GetTransientPackage());
+
+	int32 NumBroadcasts = 0;
+	int32 NumAdded = 0;
+	int32 NumRemoved = 0;
+	Request->OnSearchResultsChanged.AddLambda([&](const TArray<UCommonSession_SearchResult*>& AddedResults, const TArray<UCommonSession_SearchResult*>& RemovedResults, const TArray<UCommonSession_SearchResult*>& ChangedResults)
+	{
+		NumBroadcasts++;
+		NumAdded = AddedResults.Num();
+		NumRemoved = RemovedResults.Num();
+	});
+
+	Request->BeginResultsUpdate();
+	Request->AddResult(TEXT("SessionA"));
+	Request->AddResult(TEXT("SessionB"));
+	Request->EndResultsUpdate();
+	Request->NotifySearchFinished(true, FText());
+	TestEqual(TEXT("Successful search reports its changes"), NumBroadcasts, 1);
+	TestEqual(TEXT("New sessions are reported as added"), NumAdded, 2);
+
+	// A failed search clears the results and has to say so
+	Request->BeginResultsUpdate();
+	Request->EndResultsUpdate();
+	Request->NotifySearchFinished(false, FText());
+	TestEqual(TEXT("Failed search reports its changes"), NumBroadcasts, 2);
+	TestEqual(TEXT("Failed search removes the previous results"), NumRemoved, 2);
+	TestEqual(TEXT("Failed search has no results"), Request->Results.Num(), 0);
+
+	// Aborted searches never updated the results, the previous changes must not be reported again
+	Request->NotifySearchFinished(false, FText());
+	TestEqual(TEXT("Aborted search reports no changes"), NumBroadcasts, 2);
+
+	return true;
+}
+
+#if COMMONUSER_OSSV1
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionQuickPlayScoreTest, "CommonUser.Session.QuickPlayScore", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionQuickPlayScoreTest::RunTest(const FString& Parameters)
+{
+	UCommonSessionSubsystem* Subsystem = NewObject<UCommonSessionSubsystem>(GetTransientPackage());
+	Subsystem->QuickPlayMaxPingMs = 250;
+	Subsystem->QuickPlayPingWeight = 1.0f;
+	Subsystem->QuickPlayOccupancyWeight = 100.0f;
+	Subsystem->QuickPlayRegionMatchWeight = 50.0f;
+	Subsystem->QuickPlayPreferredRegion.Reset();
+
+	auto MakeResult = [Subsystem](int32 PingInMs, int32 OpenConnections, int32 MaxConnections)
+	{
+		UCommonSession_SearchResult* SearchResult = NewObject<UCommonSession_SearchResult>(Subsystem);
+		SearchResult->Result.PingInMs = PingInMs;
+		SearchResult->Result.Session.NumOpenPublicConnections = OpenConnections;
+		SearchResult->Result.Session.SessionSettings.NumPublicConnections = MaxConnections;
+		return SearchResult;
+	};
+
+	const float LowPingScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(20, 4, 8));
+	const float HighPingScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(200, 4, 8));
+	const float FullerScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(20, 1, 8));
+	const float TooFarScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(300, 4, 8));
+	const float UnreachableScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(MAX_QUERY_PING, 4, 8));
+	const float FullScore = FCommonSessionSubsystemTestAccess::ScoreQuickPlaySearchResult(Subsystem, MakeResult(20, 0, 8));
+
+	TestTrue(TEXT("Reachable session with open slots can be joined"), LowPingScore >= 0.0f);
+	TestTrue(TEXT("Lower ping scores higher"), LowPingScore > HighPingScore);
+	TestTrue(TEXT("Fuller session scores higher at the same ping"), FullerScore > LowPingScore);
+	TestTrue(TEXT("Session above the max ping is never joined"), TooFarScore < 0.0f);
+	TestTrue(TEXT("Unreachable session is never joined"), UnreachableScore < 0.0f);
+	TestTrue(TEXT("Full session is never joined"), FullScore < 0.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionSearchResultChangeHashTest, "CommonUser.Session.SearchResultChangeHash", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonSessionSearchResultChangeHashTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* PingBucketCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("CommonSession.SearchResultPingBucketMs"));
+	if (!TestNotNull(TEXT("Ping bucket console variable exists"), PingBucketCVar))
+	{
+		return false;
+	}
+	const int32 PreviousPingBucketMs = PingBucketCVar->GetInt();
+	PingBucketCVar->Set(50, ECVF_SetByCode);
+
+	UCommonSession_SearchResult* SearchResult = NewObject<UCommonSession_SearchResult>(GetTransientPackage());
+	SearchResult->Result.PingInMs = 60;
+	SearchResult->Result.Session.SessionSettings.Set(FName(TEXT("MAPNAME")), FString(TEXT("Arena")), EOnlineDataAdvertisementType::ViaOnlineService);
+	SearchResult->Result.Session.SessionSettings.Set(FName(TEXT("GAMEMODE")), FString(TEXT("Elimination")), EOnlineDataAdvertisementType::ViaOnlineService);
+	const uint32 OriginalHash = SearchResult->ComputeChangeHash();
+
+	SearchResult->Result.PingInMs = 70;
+	TestEqual(TEXT("Ping jitter is not a change"), SearchResult->ComputeChangeHash(), OriginalHash);
+
+	SearchResult->Result.PingInMs = 160;
+	TestNotEqual(TEXT("Large ping change is a change"), SearchResult->ComputeChangeHash(), OriginalHash);
+	SearchResult->Result.PingInMs = 60;
+
+	// The same settings stored in a different order hash the same
+	UCommonSession_SearchResult* ReorderedResult = NewObject<UCommonSession_SearchResult>(GetTransientPackage());
+	ReorderedResult->Result.PingInMs = 60;
+	ReorderedResult->Result.Session.SessionSettings.Set(FName(TEXT("GAMEMODE")), FString(TEXT("Elimination")), EOnlineDataAdvertisementType::ViaOnlineService);
+	ReorderedResult->Result.Session.SessionSettings.Set(FName(TEXT("MAPNAME")), FString(TEXT("Arena")), EOnlineDataAdvertisementType::ViaOnlineService);
+	TestEqual(TEXT("Setting order does not change the hash"), ReorderedResult->ComputeChangeHash(), OriginalHash);
+
+	ReorderedResult->Result.Session.SessionSettings.Set(FName(TEXT("MAPNAME")), FString(TEXT("Canyon")), EOnlineDataAdvertisementType::ViaOnlineService);
+	TestNotEqual(TEXT("Setting value change is a change"), ReorderedResult->ComputeChangeHash(), OriginalHash);
+
+	PingBucketCVar->Set(PreviousPingBucketMs, ECVF_SetByCode);
+	return true;
+}
+#endif // COMMONUSER_OSSV1
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonUserSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GenericPlatform/GenericPlatformInputDeviceMapper.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if COMMONUSER_OSSV1
+#include "OnlineSubsystemNames.h"
+#include "OnlineSubsystemUtils.h"
+#endif // COMMONUSER_OSSV1
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Gives the tests access to the login requests, settings and statistics of a user subsystem */
+struct FCommonUserSubsystemTestAccess
+{
+	static TSharedRef<UCommonUserSubsystem::FUserLoginRequest> MakeLoginRequest()
+	{
+		return MakeShared<UCommonUserSubsystem::FUserLoginRequest>(nullptr, ECommonUserPrivilege::CanPlayOnline, ECommonUserOnlineContext::Service, UCommonUserSubsystem::FOnLocalUserLoginCompleteDelegate());
+	}
+
+	/** Does what ProcessLoginRequest does when it leaves a privilege check running and moves on to the next context */
+	static void StartPendingPrivilegeCheck(TSharedRef<UCommonUserSubsystem::FUserLoginRequest> Request, ECommonUserOnlineContext Context)
+	{
+		Request->PendingPrivilegeChecks.Add(Context, ECommonUserAsyncTaskState::InProgress);
+		Request->PendingPrivilegeCheckStartTimes.Add(Context, FPlatformTime::Seconds());
+	}
+
+	static bool CompletePendingPrivilegeCheck(UCommonUserSubsystem* Subsystem, TSharedRef<UCommonUserSubsystem::FUserLoginRequest> Request, ECommonUserOnlineContext Context, bool bWasSuccessful)
+	{
+		return Subsystem->CompletePendingPrivilegeCheck(Request, Context, bWasSuccessful);
+	}
+
+	static ECommonUserAsyncTaskState GetPendingPrivilegeChecksState(const UCommonUserSubsystem* Subsystem, TSharedRef<UCommonUserSubsystem::FUserLoginRequest> Request)
+	{
+		return Subsystem->GetPendingPrivilegeChecksState(*Request);
+	}
+
+	static int32 GetNumTotalLoginSamples(const UCommonUserSubsystem* Subsystem)
+	{
+		return Subsystem->LoginStageLatencies[(int32)UCommonUserSubsystem::ELoginStage::Total].NumSamples;
+	}
+
+	static int32 GetNumPrivilegeCheckSamples(const UCommonUserSubsystem* Subsystem)
+	{
+		return Subsystem->LoginStageLatencies[(int32)UCommonUserSubsystem::ELoginStage::PrivilegeCheck].NumSamples;
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonUserPendingPrivilegeChecksTest, "CommonUser.User.PendingPrivilegeChecks", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonUserPendingPrivilegeChecksTest::RunTest(const FString& Parameters)
+{
+	// Only the request bookkeeping and the latency histogram are used, so the subsystem doesn't need to be initialized
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	UCommonUserSubsystem* UserSubsystem = NewObject<UCommonUserSubsystem>(GameInstance);
+	const int32 NumPrivilegeSamplesBefore = FCommonUserSubsystemTestAccess::GetNumPrivilegeCheckSamples(UserSubsystem);
+
+	// Two checks left running for earlier contexts, one of them fails
+	{
+		auto Request = FCommonUserSubsystemTestAccess::MakeLoginRequest();
+		TestTrue(TEXT("No pending checks is done"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::Done);
+
+		FCommonUserSubsystemTestAccess::StartPendingPrivilegeCheck(Request, ECommonUserOnlineContext::Platform);
+		FCommonUserSubsystemTestAccess::StartPendingPrivilegeCheck(Request, ECommonUserOnlineContext::Default);
+		TestTrue(TEXT("Both checks running"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::InProgress);
+
+		TestFalse(TEXT("A context without a pending check is ignored"), FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Service, true));
+
+		TestTrue(TEXT("Failed check completes"), FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Platform, false));
+		TestTrue(TEXT("Still waiting on the other check after a failure"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::InProgress);
+
+		TestFalse(TEXT("A check only completes once"), FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Platform, true));
+
+		TestTrue(TEXT("Successful check completes"), FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Default, true));
+		TestTrue(TEXT("A failure in any context fails the join"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::Failed);
+	}
+
+	// Two checks that both succeed, completing in the other order
+	{
+		auto Request = FCommonUserSubsystemTestAccess::MakeLoginRequest();
+		FCommonUserSubsystemTestAccess::StartPendingPrivilegeCheck(Request, ECommonUserOnlineContext::Platform);
+		FCommonUserSubsystemTestAccess::StartPendingPrivilegeCheck(Request, ECommonUserOnlineContext::Default);
+
+		FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Default, true);
+		TestTrue(TEXT("Still waiting on the first check"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::InProgress);
+
+		FCommonUserSubsystemTestAccess::CompletePendingPrivilegeCheck(UserSubsystem, Request, ECommonUserOnlineContext::Platform, true);
+		TestTrue(TEXT("All checks succeeded"), FCommonUserSubsystemTestAccess::GetPendingPrivilegeChecksState(UserSubsystem, Request) == ECommonUserAsyncTaskState::Done);
+	}
+
+	TestEqual(TEXT("Each completed check recorded its latency once"), FCommonUserSubsystemTestAccess::GetNumPrivilegeCheckSamples(UserSubsystem) - NumPrivilegeSamplesBefore, 4);
+
+	return true;
+}
+
+#if COMMONUSER_OSSV1
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonUserNullLoginTest, "CommonUser.User.NullOnlineLogin", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCommonUserNullLoginTest::RunTest(const FString& Parameters)
+{
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	auto ShutdownGameInstance = [GameInstance]()
+	{
+		UWorld* World = GameInstance->GetWorld();
+		GameInstance->Shutdown();
+		if (World)
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+		GameInstance->RemoveFromRoot();
+	};
+
+	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GameInstance->GetWorld());
+	if (!OnlineSub || OnlineSub->GetSubsystemName() != NULL_SUBSYSTEM)
+	{
+		AddInfo(TEXT("Skipping, the default online subsystem is not the Null OSS"));
+		ShutdownGameInstance();
+		return true;
+	}
+
+	UCommonUserSubsystem* UserSubsystem = GameInstance->GetSubsystem<UCommonUserSubsystem>();
+	if (!TestNotNull(TEXT("User subsystem exists"), UserSubsystem))
+	{
+		ShutdownGameInstance();
+		return false;
+	}
+
+	const int32 NumTotalSamplesBefore = FCommonUserSubsystemTestAccess::GetNumTotalLoginSamples(UserSubsystem);
+	const int32 NumPrivilegeSamplesBefore = FCommonUserSubsystemTestAccess::GetNumPrivilegeCheckSamples(UserSubsystem);
+
+	FCommonUserInitializeParams Params;
+	Params.LocalPlayerIndex = 0;
+	Params.PlatformUser = IPlatformInputDeviceMapper::Get().GetPrimaryPlatformUser();
+	Params.PrimaryInputDevice = IPlatformInputDeviceMapper::Get().GetDefaultInputDevice();
+	Params.bCanCreateNewLocalPlayer = false;
+	Params.RequestedPrivilege = ECommonUserPrivilege::CanPlayOnline;
+
+	FString CreatePlayerError;
+	if (!TestNotNull(TEXT("Local player was created"), GameInstance->CreateLocalPlayer(Params.PlatformUser, CreatePlayerError, false)))
+	{
+		ShutdownGameInstance();
+		return false;
+	}
+
+	if (!TestTrue(TEXT("Login request was started"), UserSubsystem->TryToInitializeUser(Params)))
+	{
+		ShutdownGameInstance();
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, UserSubsystem, StartTime, NumTotalSamplesBefore, NumPrivilegeSamplesBefore, ShutdownGameInstance]()
+	{
+		const ECommonUserInitializationState State = UserSubsystem->GetLocalPlayerInitializationState(0);
+		const bool bFinished = (State == ECommonUserInitializationState::LoggedInOnline || State == ECommonUserInitializationState::FailedtoLogin);
+		if (!bFinished && (FPlatformTime::Seconds() - StartTime) < 10.0)
+		{
+			return false;
+		}
+
+		TestTrue(TEXT("Login pipeline completed"), bFinished);
+		TestTrue(TEXT("User logged in online"), State == ECommonUserInitializationState::LoggedInOnline);
+		TestTrue(TEXT("Login latency was recorded"), FCommonUserSubsystemTestAccess::GetNumTotalLoginSamples(UserSubsystem) > NumTotalSamplesBefore);
+		TestTrue(TEXT("Privilege check latency was recorded"), FCommonUserSubsystemTestAccess::GetNumPrivilegeCheckSamples(UserSubsystem) > NumPrivilegeSamplesBefore);
+
+		ShutdownGameInstance();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // COMMONUSER_OSSV1
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -22,6 +22,7 @@ class AOnlineBeaconHost;
 class ULocalPlayer;
 namespace ETravelFailure { enum Type : int; }
 struct FOnlineResultInformation;
+struct FStreamableHandle;
 
 #if COMMONUSER_OSSV1
 #include "Interfaces/OnlineSessionInterface.h"
@@ -149,6 +150,15 @@ public:
 	UFUNCTION(BlueprintPure, Category=Sessions)
 	COMMONUSER_API int32 GetPingInMs() const;
 
+	/** Returns a key that identifies the session across searches, used to update results in place */
+	COMMONUSER_API FString GetSessionKey() const;
+
+	/** Returns a hash of the values that can change between searches for the same session (player counts, ping bucket, settings) */
+	COMMONUSER_API uint32 ComputeChangeHash() const;
+
+	/** Copies the platform-specific result from another result object */
+	COMMONUSER_API void CopyResultFrom(const UCommonSession_SearchResult& Other);
+
 public:
 	/** Pointer to the platform-specific implementation */
 #if COMMONUSER_OSSV1
@@ -159,6 +169,11 @@ public:
 	UE::Online::FOnlineSessionId SessionID;
 #endif // COMMONUSER_OSSV1
 
+private:
+	friend class UCommonSession_SearchSessionRequest;
+
+	/** ComputeChangeHash at the time of the last search that returned this result */
+	uint32 LastChangeHash = 0;
 };
 
 
@@ -169,6 +184,10 @@ public:
 DECLARE_MULTICAST_DELEGATE_TwoParams(FCommonSession_FindSessionsFinished, bool bSucceeded, const FText& ErrorMessage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FCommonSession_FindSessionsFinishedDynamic, bool, bSucceeded, FText, ErrorMessage);
 
+/** Delegates called when a successful session search completes, with the differences to the previous results of the same request */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FCommonSession_SearchResultsChanged, const TArray<UCommonSession_SearchResult*>& AddedResults, const TArray<UCommonSession_SearchResult*>& RemovedResults, const TArray<UCommonSession_SearchResult*>& ChangedResults);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FCommonSession_SearchResultsChangedDynamic, const TArray<UCommonSession_SearchResult*>&, AddedResults, const TArray<UCommonSession_SearchResult*>&, RemovedResults, const TArray<UCommonSession_SearchResult*>&, ChangedResults);
+
 /** Request object describing a session search, this object will be updated once the search has completed */
 UCLASS(MinimalAPI, BlueprintType)
 class UCommonSession_SearchSessionRequest : public UObject
@@ -191,13 +210,54 @@ public:
 	/** Native Delegate called when a session search completes */
 	FCommonSession_FindSessionsFinished OnSearchFinished;
 
+	/** Native Delegate called before OnSearchFinished when a search completes, with the results that were added, removed or changed since the last search. Failed searches remove all results */
+	FCommonSession_SearchResultsChanged OnSearchResultsChanged;
+
 	/** Called by subsystem to execute finished delegates */
 	COMMONUSER_API void NotifySearchFinished(bool bSucceeded, const FText& ErrorMessage);
 
+	/** Called by subsystem before filling in the results of a new search, the previous result objects are kept to be updated in place or recycled */
+	COMMONUSER_API void BeginResultsUpdate();
+
+	/** Called by subsystem for each found session, returns the previous result object for the same session or a recycled one */
+	COMMONUSER_API UCommonSession_SearchResult* AddResult(const FString& SessionKey);
+
+	/** Called by subsystem once all results were added, works out what was added, removed or changed */
+	COMMONUSER_API void EndResultsUpdate();
+
+	/** Called by subsystem to update the results from ones found by a different request */
+	COMMONUSER_API void CopyResultsFrom(TArray<TObjectPtr<UCommonSession_SearchResult>> SourceResults);
+
 private:
 	/** Delegate called when a session search completes */
 	UPROPERTY(BlueprintAssignable, Category = "Events", meta = (DisplayName = "On Search Finished", AllowPrivateAccess = true))
 	FCommonSession_FindSessionsFinishedDynamic K2_OnSearchFinished;
+
+	/** Delegate called before On Search Finished when a search completes, with the results that were added, removed or changed since the last search */
+	UPROPERTY(BlueprintAssignable, Category = "Events", meta = (DisplayName = "On Search Results Changed", AllowPrivateAccess = true))
+	FCommonSession_SearchResultsChangedDynamic K2_OnSearchResultsChanged;
+
+	/** Results of the previous search that have not been found again yet, only valid during an update */
+	UPROPERTY(Transient)
+	TMap<FString, TObjectPtr<UCommonSession_SearchResult>> PreviousResultsByKey;
+
+	/** Result objects that are no longer in use and can be recycled for new sessions */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> ResultPool;
+
+	/** Differences to the previous results, see OnSearchResultsChanged */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> AddedResults;
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> RemovedResults;
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> ChangedResults;
+
+	/** Results reused from the previous search during the current update */
+	TSet<UCommonSession_SearchResult*> ReusedResults;
+
+	/** True if the results were updated since the last time listeners were notified */
+	bool bResultsUpdated = false;
 };
 
 
@@ -357,6 +417,42 @@ public:
 	UPROPERTY(Config)
 	bool bUseBeacons = true;
 
+	/** If true, the reservation beacon request is sent at the same time as the online session join (when the OSS can resolve the beacon address from the search result) */
+	UPROPERTY(Config)
+	bool bPipelineJoinReservation = true;
+
+	/** If true, the map advertised by a session starts loading as soon as the join starts, so it is ready when we travel */
+	UPROPERTY(Config)
+	bool bPreloadMapWhileJoining = true;
+
+	/** How long (in seconds) the results of a session search are reused for new searches with the same options, 0 disables caching */
+	UPROPERTY(Config)
+	float SearchResultCacheDuration = 5.0f;
+
+	/** Quick play will not join sessions with a ping above this */
+	UPROPERTY(Config)
+	int32 QuickPlayMaxPingMs = 250;
+
+	/** Quick play score lost for each millisecond of ping */
+	UPROPERTY(Config)
+	float QuickPlayPingWeight = 1.0f;
+
+	/** Quick play score gained for a full session (scaled by how full it is), so players are packed into populated games */
+	UPROPERTY(Config)
+	float QuickPlayOccupancyWeight = 100.0f;
+
+	/** Quick play score gained for sessions advertising QuickPlayPreferredRegion */
+	UPROPERTY(Config)
+	float QuickPlayRegionMatchWeight = 50.0f;
+
+	/** The session setting that holds the region a session is hosted in */
+	UPROPERTY(Config)
+	FName QuickPlayRegionSettingKey = TEXT("REGION");
+
+	/** The region quick play prefers, empty to ignore regions */
+	UPROPERTY(Config)
+	FString QuickPlayPreferredRegion;
+
 protected:
 	// Functions called during the process of creating or joining a session, these can be overidden for game-specific behavior
 
@@ -364,7 +460,19 @@ protected:
 	COMMONUSER_API virtual TSharedRef<FCommonOnlineSearchSettings> CreateQuickPlaySearchSettings(UCommonSession_HostSessionRequest* Request, UCommonSession_SearchSessionRequest* QuickPlayRequest);
 
 	/** Called when a quick play search finishes, can be overridden for game-specific behavior */
-	COMMONUSER_API virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
+	COMMONUSER_API virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<UCommonSession_SearchSessionRequest> QuickPlayRequest, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
+
+	/** Returns how desirable a search result is for quick play based on ping, player count and region, higher is better. Results scoring below zero are never joined */
+	COMMONUSER_API virtual float ScoreQuickPlaySearchResult(const UCommonSession_SearchResult* SearchResult, const UCommonSession_HostSessionRequest* HostRequest) const;
+
+	/**
+	 * Returns true if two searches (see GetSearchQueryKey) query the online service the same way, so one can be given
+	 * the results of the other.  By default only identical queries share results.
+	 */
+	COMMONUSER_API virtual bool CanShareSearchResults(const FString& QueryKeyA, const FString& QueryKeyB) const;
+
+	/** Returns a key describing everything the search asks for (online mode, lobbies, query settings or lobby filters, max results) */
+	static COMMONUSER_API FString GetSearchQueryKey(const FCommonOnlineSearchSettings& InSearchSettings);
 
 	/** Called when traveling to a session fails */
 	COMMONUSER_API virtual void TravelLocalSessionFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ReasonString);
@@ -393,6 +501,22 @@ protected:
 	COMMONUSER_API void NotifyDestroySessionRequested(const FPlatformUserId& PlatformUserId, const FName& SessionName);
 	COMMONUSER_API void SetCreateSessionError(const FText& ErrorText);
 
+	/** Completes the current search, updating the result cache and passing the results on to any searches that piggybacked on it */
+	COMMONUSER_API void FinishSessionSearch(bool bSucceeded, const FText& ErrorMessage);
+
+	/** Adds the request to the pending search if it has the same query, otherwise aborts the pending search. Returns true if the request will get the pending search's results */
+	COMMONUSER_API bool TryPiggybackOnPendingSearch(UCommonSession_SearchSessionRequest* Request, const FString& QueryKey);
+
+	/** Returns true if the cached results are recent enough and were found with a query that can be shared with QueryKey, throws them away once expired */
+	COMMONUSER_API bool CanUseSearchResultCache(const FString& QueryKey, double CurrentTime);
+
+	/** Fills in the request from the cached results of a recent compatible search and notifies it next tick, returns false if there are none */
+	COMMONUSER_API bool TryFindSessionsFromCache(UCommonSession_SearchSessionRequest* Request, const FString& QueryKey);
+	COMMONUSER_API void HandleCachedSearchFinished(TWeakObjectPtr<UCommonSession_SearchSessionRequest> Request);
+
+	/** Throws away the cached search results, called when they are likely out of date */
+	COMMONUSER_API void InvalidateSearchResultCache();
+
 #if COMMONUSER_OSSV1
 	COMMONUSER_API void BindOnlineDelegatesOSSv1();
 	COMMONUSER_API void CreateOnlineSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
@@ -444,6 +568,21 @@ protected:
 	COMMONUSER_API void ConnectToHostReservationBeacon();
 	COMMONUSER_API void DestroyHostReservationBeacon();
 
+#if COMMONUSER_OSSV1
+	/** Spawns the beacon client and requests a reservation on the host at ConnectInfo */
+	COMMONUSER_API void RequestHostReservation(const FString& ConnectInfo, const FString& SessionIdStr);
+
+	/** Called when both the session join and the reservation have succeeded, notifies and travels */
+	COMMONUSER_API void CompleteJoinSession();
+#endif // COMMONUSER_OSSV1
+
+	/** Called when either the session join or the reservation failed, notifies and cleans up once */
+	COMMONUSER_API void FailJoinSession(const FOnlineResultInformation& JoinSessionResult);
+
+	/** Starts loading the map a session we are joining is running, so it is already in memory when we travel */
+	COMMONUSER_API void StartPreloadingSessionMap(const FString& MapName);
+	COMMONUSER_API void StopPreloadingSessionMap();
+
 protected:
 	/** The travel URL that will be used after session operations are complete */
 	FString PendingTravelURL;
@@ -460,6 +599,48 @@ protected:
 	/** Settings for the current search */
 	TSharedPtr<FCommonOnlineSearchSettings> SearchSettings;
 
+	/** Query key of the current search, taken before it was sent (see GetSearchQueryKey) */
+	FString SearchQueryKey;
+
+	/** Search requests made while the current search was in progress, they get the same results when it finishes */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> PiggybackedSearchRequests;
+
+	/** Search requests that were filled in from the cache and are waiting to be notified */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> PendingCachedSearchRequests;
+
+	/** Results of the most recent successful search, see SearchResultCacheDuration */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> CachedSearchResults;
+
+	/** Query key of the search the cached results were found for, only identical searches can use them */
+	FString CachedSearchQueryKey;
+
+	/** Time the cached results were found, or a negative number if there are none */
+	double CachedSearchResultsTime = -1.0;
+
+	friend struct FCommonSessionSubsystemTestAccess;
+
+	/** Handle keeping the map of the session we are joining loaded until we arrive there */
+	TSharedPtr<FStreamableHandle> SessionMapPreloadHandle;
+
+	/** Time the current join started, for logging how long it took to get to the server */
+	double JoinSessionStartTime = 0.0;
+
+	/** True if the reservation for the current join was requested alongside the session join */
+	bool bJoinReservationPipelined = false;
+
+	/** Progress of the current pipelined join, we only travel once both have succeeded */
+	bool bJoinSessionSucceeded = false;
+	bool bJoinReservationAccepted = false;
+
+	/** True once the current join has failed and been reported */
+	bool bJoinSessionFailed = false;
+
+	/** True while the online session join is in progress, cleaning up after a failed pipelined reservation waits for it */
+	bool bJoinSessionInFlight = false;
+
 	/** General beacon listener for registering beacons with */
 	UPROPERTY(Transient)
 	TWeakObjectPtr<AOnlineBeaconHost> BeaconHostListener;
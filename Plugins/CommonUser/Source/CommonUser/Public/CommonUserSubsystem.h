@@ -124,6 +124,9 @@ public:
 
 		/** Cached values of various user privileges */
 		TMap<ECommonUserPrivilege, ECommonUserPrivilegeResult> CachedPrivileges;
+
+		/** Privileges whose cached value came from the persisted user cache and has not been confirmed by the online system yet */
+		TSet<ECommonUserPrivilege> PrivilegesToRevalidate;
 	};
 
 	/** Per context cache, game will always exist but others may not */
@@ -429,7 +432,40 @@ public:
 	/** True if there is a separate platform and service interface */
 	COMMONUSER_API bool HasSeparatePlatformContext() const;
 
+	/** Returns a human readable histogram of how long each login stage has taken, for profiling time to online ready */
+	UFUNCTION(BlueprintCallable, Category = CommonUser)
+	COMMONUSER_API FString GetLoginLatencyReport() const;
+
 protected:
+	/** Stages of a login request that are timed for the latency histogram */
+	enum class ELoginStage : uint8
+	{
+		TransferPlatformAuth,
+		AutoLogin,
+		LoginUI,
+		PrivilegeCheck,
+		/** Entire request, from LoginLocalUser until the completion delegate */
+		Total,
+
+		Count
+	};
+
+	/** Histogram of login stage durations, with fixed millisecond buckets */
+	struct FLoginLatencyHistogram
+	{
+		/** Upper bound of each bucket in milliseconds, the last bucket is open-ended */
+		static constexpr int32 NumBuckets = 8;
+		static constexpr double BucketLimitsMs[NumBuckets - 1] = { 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0 };
+
+		int32 BucketCounts[NumBuckets] = {};
+		int32 NumSamples = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+
+		void AddSample(double DurationMs);
+		FString ToString() const;
+	};
+
 	/** Internal structure that caches status and pointers for each online context */
 	struct FOnlineContextCache
 	{
@@ -512,6 +548,15 @@ protected:
 
 		/** Most recent/relevant error to display to user */
 		TOptional<FOnlineErrorType> Error;
+
+		/** Privilege checks still running for earlier contexts, these must all finish before the request completes. See bParallelizeLoginContexts */
+		TMap<ECommonUserOnlineContext, ECommonUserAsyncTaskState> PendingPrivilegeChecks;
+
+		/** When each stage of the current context was started, or 0 if it is not running */
+		double StageStartTimes[(int32)ELoginStage::Count] = {};
+
+		/** When each pending privilege check was started */
+		TMap<ECommonUserOnlineContext, double> PendingPrivilegeCheckStartTimes;
 	};
 
 
@@ -524,6 +569,37 @@ protected:
 	/** Refresh user info from OSS */
 	COMMONUSER_API virtual void RefreshLocalUserInfo(UCommonUserInfo* UserInfo);
 
+	/** Rebuilds the platform user and net id lookup tables, call after changing the platform user, guest state or net ids of any user */
+	COMMONUSER_API void RefreshUserInfoLookups();
+
+	/** Last known results for one net id, saved between runs when bPersistUserCache is set */
+	struct FPersistedUserCacheEntry
+	{
+		FString Nickname;
+		TMap<uint8, uint8> PrivilegeResults;
+		FDateTime SavedTime;
+
+		friend FArchive& operator<<(FArchive& Ar, FPersistedUserCacheEntry& Entry)
+		{
+			return Ar << Entry.Nickname << Entry.PrivilegeResults << Entry.SavedTime;
+		}
+	};
+
+	/** Returns the file the persisted user cache is stored in */
+	COMMONUSER_API virtual FString GetPersistedUserCachePath() const;
+
+	/** Reads the persisted user cache from disk, dropping expired entries */
+	COMMONUSER_API virtual void LoadPersistedUserCache();
+
+	/** Writes the persisted user cache to disk */
+	COMMONUSER_API virtual void SavePersistedUserCache();
+
+	/** Seeds the nickname and privileges of a user context from the persisted cache, if it has an unexpired entry for the net id */
+	COMMONUSER_API virtual void ApplyPersistedUserCache(UCommonUserInfo* UserInfo, ECommonUserOnlineContext Context);
+
+	/** Copies the current nickname and privileges of a user context into the persisted cache and schedules a save */
+	COMMONUSER_API virtual void UpdatePersistedUserCache(UCommonUserInfo* UserInfo, ECommonUserOnlineContext Context);
+
 	/** Possibly send privilege availability notification, compares current value to cached old value */
 	COMMONUSER_API virtual void HandleChangedAvailability(UCommonUserInfo* UserInfo, ECommonUserPrivilege Privilege, ECommonUserAvailability OldAvailability);
 
@@ -547,6 +623,21 @@ protected:
 	/** Performs the next step of a login request, which could include completing it. Returns true if it's done */
 	COMMONUSER_API virtual void ProcessLoginRequest(TSharedRef<FUserLoginRequest> Request);
 
+	/** Marks a login stage as started, for the latency histogram */
+	COMMONUSER_API void BeginLoginStage(TSharedRef<FUserLoginRequest> Request, ELoginStage Stage);
+
+	/** Records the duration of any started login stages that are no longer in progress */
+	COMMONUSER_API void UpdateLoginStageLatencies(TSharedRef<FUserLoginRequest> Request);
+
+	/** Adds a stage duration to the latency histogram */
+	COMMONUSER_API void RecordLoginStageLatency(ELoginStage Stage, double StartTime, ECommonUserOnlineContext Context);
+
+	/** Updates a privilege check that was left running while the request moved on to a later context, returns true if the request was waiting on it */
+	COMMONUSER_API bool CompletePendingPrivilegeCheck(TSharedRef<FUserLoginRequest> Request, ECommonUserOnlineContext Context, bool bWasSuccessful);
+
+	/** Joins the pending privilege checks of a request: InProgress while any is running, otherwise Failed if any failed, else Done */
+	COMMONUSER_API ECommonUserAsyncTaskState GetPendingPrivilegeChecksState(const FUserLoginRequest& Request) const;
+
 	/** Call login on OSS, with platform auth from the platform OSS. Return true if AutoLogin started */
 	COMMONUSER_API virtual bool TransferPlatformAuth(FOnlineContextCache* System, TSharedRef<FUserLoginRequest> Request, FPlatformUserId PlatformUser);
 
@@ -633,9 +724,47 @@ protected:
 	/** List of current in progress login requests */
 	TArray<TSharedRef<FUserLoginRequest>> ActiveLoginRequests;
 
+	/**
+	 * If true, a game login will not wait for the platform privilege check before starting to log into the service context.
+	 * The privilege checks for each context then run concurrently and are all joined before the login request completes.
+	 * This changes the order platforms see the requests in (the service login can start before the platform allowed play),
+	 * so it is off by default and should only be enabled after checking platform requirements.
+	 */
+	UPROPERTY(Config)
+	bool bParallelizeLoginContexts = false;
+
+	/**
+	 * If true, the last known privilege results and nickname of each user are saved to disk and used at startup before the online system responds.
+	 * Cached privileges still count for login requests, but are checked again in the background and broadcast through OnUserPrivilegeChanged if they changed.
+	 */
+	UPROPERTY(Config)
+	bool bPersistUserCache = false;
+
+	/** How long entries in the persisted user cache can be used for, in seconds */
+	UPROPERTY(Config)
+	float PersistedUserCacheLifetime = 86400.0f;
+
+	/** Persisted user cache, from net id string to the last known results */
+	TMap<FString, FPersistedUserCacheEntry> PersistedUserCache;
+
+	/** True while the persisted cache is being applied to a user, so it does not get written back with a new save time */
+	bool bApplyingPersistedUserCache = false;
+
+	/** True if a save of the persisted user cache is scheduled for next tick */
+	bool bPersistedUserCacheSaveQueued = false;
+
+	/** Duration of each login stage for all requests processed by this subsystem */
+	FLoginLatencyHistogram LoginStageLatencies[(int32)ELoginStage::Count];
+
 	/** Information about each local user, from local player index to user */
 	UPROPERTY()
 	TMap<int32, TObjectPtr<UCommonUserInfo>> LocalUserInfos;
+
+	/** Lookup table from platform user to the first non-guest user info with it, see GetUserInfoForPlatformUser */
+	TMap<FPlatformUserId, TWeakObjectPtr<UCommonUserInfo>> UserInfosByPlatformUser;
+
+	/** Lookup table from any cached net id to the user info it belongs to, see GetUserInfoForUniqueNetId */
+	TMap<FUniqueNetIdRepl, TWeakObjectPtr<UCommonUserInfo>> UserInfosByNetId;
 	
 	/** Cached platform/mode trait tags */
 	FGameplayTagContainer CachedTraitTags;
@@ -646,4 +775,5 @@ protected:
 	FOnlineContextCache* PlatformContextInternal = nullptr;
 
 	friend UCommonUserInfo;
+	friend struct FCommonUserSubsystemTestAccess;
 };
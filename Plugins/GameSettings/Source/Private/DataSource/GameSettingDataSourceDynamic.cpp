@@ -3,6 +3,7 @@
 #include "DataSource/GameSettingDataSourceDynamic.h"
 
 #include "Engine/LocalPlayer.h"
+#include "UObject/UnrealType.h"
 
 //--------------------------------------
 // FGameSettingDataSourceDynamic
@@ -15,7 +16,138 @@ FGameSettingDataSourceDynamic::FGameSettingDataSourceDynamic(const TArray<FStrin
 
 bool FGameSettingDataSourceDynamic::Resolve(ULocalPlayer* InLocalPlayer)
 {
-	return DynamicPath.Resolve(InLocalPlayer);
+	const bool bResolved = DynamicPath.Resolve(InLocalPlayer);
+
+	// Remember the leaf type so typed access can go straight through the cached property chain
+	LeafValueType = bResolved ? GetLeafValueType(DynamicPath) : EValueType::Unknown;
+
+	return bResolved;
+}
+
+FGameSettingDataSourceDynamic::EValueType FGameSettingDataSourceDynamic::GetLeafValueType(const FCachedPropertyPath& InPath)
+{
+	if (InPath.GetNumSegments() == 0)
+	{
+		return EValueType::Unknown;
+	}
+
+	const FFieldVariant LeafField = InPath.GetLastSegment().GetField();
+
+	const FProperty* LeafProperty = LeafField.Get<FProperty>();
+	if (const UFunction* LeafFunction = LeafField.Get<UFunction>())
+	{
+		// Getters are read through their return value, setters written through their only parameter
+		LeafProperty = LeafFunction->GetReturnProperty();
+		if (LeafProperty == nullptr)
+		{
+			for (TFieldIterator<FProperty> ParamIt(LeafFunction); ParamIt && ParamIt->HasAnyPropertyFlags(CPF_Parm); ++ParamIt)
+			{
+				LeafProperty = *ParamIt;
+				break;
+			}
+		}
+	}
+
+	if (LeafProperty == nullptr)
+	{
+		return EValueType::Unknown;
+	}
+	else if (LeafProperty->IsA<FBoolProperty>())
+	{
+		return EValueType::Bool;
+	}
+	else if (LeafProperty->IsA<FByteProperty>())
+	{
+		return EValueType::Byte;
+	}
+	else if (LeafProperty->IsA<FIntProperty>())
+	{
+		return EValueType::Int32;
+	}
+	else if (LeafProperty->IsA<FInt64Property>())
+	{
+		return EValueType::Int64;
+	}
+	else if (LeafProperty->IsA<FFloatProperty>())
+	{
+		return EValueType::Float;
+	}
+	else if (LeafProperty->IsA<FDoubleProperty>())
+	{
+		return EValueType::Double;
+	}
+
+	// Enums, structs, strings etc. only go through the string path
+	return EValueType::Unknown;
+}
+
+template<typename ValueType>
+bool FGameSettingDataSourceDynamic::GetNumericValue(ULocalPlayer* InLocalPlayer, ValueType& OutValue) const
+{
+	bool bSuccess = false;
+
+	switch (LeafValueType)
+	{
+	case EValueType::Byte:
+	{
+		uint8 Value = 0;
+		bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, Value);
+		OutValue = (ValueType)Value;
+		break;
+	}
+	case EValueType::Int32:
+	{
+		int32 Value = 0;
+		bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, Value);
+		OutValue = (ValueType)Value;
+		break;
+	}
+	case EValueType::Int64:
+	{
+		int64 Value = 0;
+		bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, Value);
+		OutValue = (ValueType)Value;
+		break;
+	}
+	case EValueType::Float:
+	{
+		float Value = 0.0f;
+		bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, Value);
+		OutValue = (ValueType)Value;
+		break;
+	}
+	case EValueType::Double:
+	{
+		double Value = 0.0;
+		bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, Value);
+		OutValue = (ValueType)Value;
+		break;
+	}
+	default:
+		break;
+	}
+
+	return bSuccess;
+}
+
+template<typename ValueType>
+bool FGameSettingDataSourceDynamic::SetNumericValue(ULocalPlayer* InLocalPlayer, ValueType InValue)
+{
+	switch (LeafValueType)
+	{
+	case EValueType::Byte:
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, (uint8)InValue);
+	case EValueType::Int32:
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, (int32)InValue);
+	case EValueType::Int64:
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, (int64)InValue);
+	case EValueType::Float:
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, (float)InValue);
+	case EValueType::Double:
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, (double)InValue);
+	default:
+		return false;
+	}
 }
 
 FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPlayer) const
@@ -34,6 +166,71 @@ void FGameSettingDataSourceDynamic::SetValue(ULocalPlayer* InLocalPlayer, const
 	ensure(bSuccess);
 }
 
+bool FGameSettingDataSourceDynamic::GetValueAsBool(ULocalPlayer* InLocalPlayer, bool& OutValue) const
+{
+	if (LeafValueType == EValueType::Bool)
+	{
+		return PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, OutValue);
+	}
+
+	return false;
+}
+
+bool FGameSettingDataSourceDynamic::GetValueAsInt(ULocalPlayer* InLocalPlayer, int64& OutValue) const
+{
+	if (LeafValueType == EValueType::Bool)
+	{
+		bool bValue = false;
+		const bool bSuccess = PropertyPathHelpers::GetPropertyValue(InLocalPlayer, DynamicPath, bValue);
+		OutValue = bValue ? 1 : 0;
+		return bSuccess;
+	}
+
+	// Floating point values don't convert to an integer without losing information
+	if (LeafValueType == EValueType::Float || LeafValueType == EValueType::Double)
+	{
+		return false;
+	}
+
+	return GetNumericValue(InLocalPlayer, OutValue);
+}
+
+bool FGameSettingDataSourceDynamic::GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const
+{
+	return GetNumericValue(InLocalPlayer, OutValue);
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromBool(ULocalPlayer* InLocalPlayer, bool InValue)
+{
+	if (LeafValueType == EValueType::Bool)
+	{
+		return PropertyPathHelpers::SetPropertyValue(InLocalPlayer, DynamicPath, InValue);
+	}
+
+	return false;
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromInt(ULocalPlayer* InLocalPlayer, int64 InValue)
+{
+	if (LeafValueType == EValueType::Bool)
+	{
+		return SetValueFromBool(InLocalPlayer, InValue != 0);
+	}
+
+	return SetNumericValue(InLocalPlayer, InValue);
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromDouble(ULocalPlayer* InLocalPlayer, double InValue)
+{
+	// Let the string path decide how a fractional value maps onto an integer property
+	if (LeafValueType != EValueType::Float && LeafValueType != EValueType::Double)
+	{
+		return false;
+	}
+
+	return SetNumericValue(InLocalPlayer, InValue);
+}
+
 FString FGameSettingDataSourceDynamic::ToString() const
 {
 	return DynamicPath.ToString();
@@ -80,6 +80,8 @@ void UGameSetting::StartupComplete()
 	{
 		bReady = true;
 		OnInitialized();
+
+		OnSettingReadyEvent.Broadcast(this);
 	}
 }
 
@@ -242,6 +244,27 @@ void UGameSetting::RefreshEditableState(bool bNotifyEditConditionsChanged)
 	}
 }
 
+bool UGameSetting::RefreshEditableStateIfChanged()
+{
+	if (!LocalPlayer || bOnEditConditionsChangedEventGuard)
+	{
+		return false;
+	}
+
+	TGuardValue<bool> Guard(bOnEditConditionsChangedEventGuard, true);
+
+	FGameSettingEditableState NewEditableState = ComputeEditableState();
+	if (NewEditableState == EditableStateCache)
+	{
+		return false;
+	}
+
+	EditableStateCache = MoveTemp(NewEditableState);
+	NotifyEditConditionsChanged();
+
+	return true;
+}
+
 void UGameSetting::NotifyEditConditionsChanged()
 {
 	OnEditConditionsChanged();
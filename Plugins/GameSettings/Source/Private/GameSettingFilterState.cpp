@@ -27,6 +27,209 @@ private:
 	const UGameSetting& Setting;
 };
 
+class FIndexedSettingFilterExpressionContext : public ITextFilterExpressionContext
+{
+public:
+	explicit FIndexedSettingFilterExpressionContext(const FTextFilterString& InSearchableText) : SearchableText(InSearchableText) {}
+
+	virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+	{
+		return SearchableText.CompareText(InValue, InTextComparisonMode);
+	}
+
+	virtual bool TestComplexExpression(const FName& InKey, const FTextFilterString& InValue, const ETextFilterComparisonOperation InComparisonOperation, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+	{
+		return false;
+	}
+
+private:
+	/** Prepared display name and description of the setting being filtered. */
+	const FTextFilterString& SearchableText;
+};
+
+//--------------------------------------
+// FGameSettingSearchIndex
+//--------------------------------------
+
+void FGameSettingSearchIndex::Build(const TArray<TObjectPtr<UGameSetting>>& InSettings)
+{
+	Settings.Reset(InSettings.Num());
+	SettingIndices.Reset();
+	ParentIndices.Reset(InSettings.Num());
+	SearchableTexts.Reset(InSettings.Num());
+	SearchableTextRevisions.Reset(InSettings.Num());
+
+	for (const UGameSetting* Setting : InSettings)
+	{
+		if (Setting)
+		{
+			SettingIndices.Add(Setting, Settings.Add(Setting));
+		}
+	}
+
+	for (const UGameSetting* Setting : Settings)
+	{
+		// Skip over any parents that aren't registered, so the allow list can still be resolved through them
+		int32 ParentIndex = INDEX_NONE;
+		for (const UGameSetting* Parent = Setting->GetSettingParent(); Parent && ParentIndex == INDEX_NONE; Parent = Parent->GetSettingParent())
+		{
+			ParentIndex = FindSettingIndex(Parent);
+		}
+		ParentIndices.Add(ParentIndex);
+
+		SearchableTexts.Emplace(Setting->GetDisplayName().ToString() + TEXT(" ") + Setting->GetDescriptionPlainText());
+		SearchableTextRevisions.Add(Setting->GetSearchableTextRevision());
+	}
+
+	BuildTrigrams();
+}
+
+void FGameSettingSearchIndex::RefreshChangedSettings()
+{
+	bool bAnyChanged = false;
+
+	for (int32 SettingIndex = 0; SettingIndex < Settings.Num(); SettingIndex++)
+	{
+		const UGameSetting* Setting = Settings[SettingIndex];
+		if (SearchableTextRevisions[SettingIndex] != Setting->GetSearchableTextRevision())
+		{
+			SearchableTexts[SettingIndex] = FTextFilterString(Setting->GetDisplayName().ToString() + TEXT(" ") + Setting->GetDescriptionPlainText());
+			SearchableTextRevisions[SettingIndex] = Setting->GetSearchableTextRevision();
+			bAnyChanged = true;
+		}
+	}
+
+	if (bAnyChanged)
+	{
+		BuildTrigrams();
+	}
+}
+
+void FGameSettingSearchIndex::BuildTrigrams()
+{
+	TrigramSettings.Reset();
+
+	for (int32 SettingIndex = 0; SettingIndex < SearchableTexts.Num(); SettingIndex++)
+	{
+		const FString& Text = SearchableTexts[SettingIndex].AsString();
+		for (int32 CharIndex = 0; CharIndex + 3 <= Text.Len(); CharIndex++)
+		{
+			// Settings are visited in order, so checking the last entry is enough to keep each list unique and sorted
+			TArray<int32>& TrigramList = TrigramSettings.FindOrAdd(MakeTrigram(*Text + CharIndex));
+			if (TrigramList.Num() == 0 || TrigramList.Last() != SettingIndex)
+			{
+				TrigramList.Add(SettingIndex);
+			}
+		}
+	}
+}
+
+void FGameSettingSearchIndex::GatherAllowedSettings(const TArray<TObjectPtr<UGameSetting>>& InAllowList, TBitArray<>& OutAllowedSettings) const
+{
+	OutAllowedSettings.Init(false, Settings.Num());
+
+	for (const UGameSetting* AllowedSetting : InAllowList)
+	{
+		const int32 SettingIndex = FindSettingIndex(AllowedSetting);
+		if (SettingIndex != INDEX_NONE)
+		{
+			OutAllowedSettings[SettingIndex] = true;
+		}
+	}
+
+	for (int32 SettingIndex = 0; SettingIndex < Settings.Num(); SettingIndex++)
+	{
+		for (int32 ParentIndex = ParentIndices[SettingIndex]; ParentIndex != INDEX_NONE && !OutAllowedSettings[SettingIndex]; ParentIndex = ParentIndices[ParentIndex])
+		{
+			if (OutAllowedSettings[ParentIndex])
+			{
+				OutAllowedSettings[SettingIndex] = true;
+			}
+		}
+	}
+}
+
+void FGameSettingSearchIndex::GatherSearchMatches(const FTextFilterExpressionEvaluator& InEvaluator, TBitArray<>& OutMatchingSettings) const
+{
+	const FString SearchText = InEvaluator.GetFilterText().ToString().TrimStartAndEnd().ToUpper();
+	if (SearchText.IsEmpty())
+	{
+		OutMatchingSettings.Init(true, Settings.Num());
+		return;
+	}
+
+	OutMatchingSettings.Init(false, Settings.Num());
+
+	// Only a single plain word can be narrowed down with trigrams, anything with operators, quotes or several
+	// terms is tested against every setting (still without touching the settings themselves).
+	bool bUseTrigrams = SearchText.Len() >= 3;
+	for (const TCHAR Char : SearchText)
+	{
+		if (!FChar::IsAlnum(Char) && Char != TEXT('_'))
+		{
+			bUseTrigrams = false;
+			break;
+		}
+	}
+
+	TArray<int32> Candidates;
+	if (bUseTrigrams)
+	{
+		for (int32 CharIndex = 0; CharIndex + 3 <= SearchText.Len(); CharIndex++)
+		{
+			const TArray<int32>* TrigramList = TrigramSettings.Find(MakeTrigram(*SearchText + CharIndex));
+			if (TrigramList == nullptr)
+			{
+				return;
+			}
+
+			if (CharIndex == 0)
+			{
+				Candidates = *TrigramList;
+			}
+			else
+			{
+				// Both lists are sorted, intersect them in place
+				int32 NumKept = 0;
+				for (int32 CandidateIndex = 0, TrigramIndex = 0; CandidateIndex < Candidates.Num() && TrigramIndex < TrigramList->Num();)
+				{
+					if (Candidates[CandidateIndex] < (*TrigramList)[TrigramIndex])
+					{
+						CandidateIndex++;
+					}
+					else if (Candidates[CandidateIndex] > (*TrigramList)[TrigramIndex])
+					{
+						TrigramIndex++;
+					}
+					else
+					{
+						Candidates[NumKept++] = Candidates[CandidateIndex++];
+						TrigramIndex++;
+					}
+				}
+				Candidates.SetNum(NumKept, EAllowShrinking::No);
+			}
+
+			if (Candidates.Num() == 0)
+			{
+				return;
+			}
+		}
+
+		for (const int32 SettingIndex : Candidates)
+		{
+			OutMatchingSettings[SettingIndex] = InEvaluator.TestTextFilter(FIndexedSettingFilterExpressionContext(SearchableTexts[SettingIndex]));
+		}
+	}
+	else
+	{
+		for (int32 SettingIndex = 0; SettingIndex < Settings.Num(); SettingIndex++)
+		{
+			OutMatchingSettings[SettingIndex] = InEvaluator.TestTextFilter(FIndexedSettingFilterExpressionContext(SearchableTexts[SettingIndex]));
+		}
+	}
+}
+
 //--------------------------------------
 // FGameSettingFilterState
 //--------------------------------------
@@ -40,16 +243,54 @@ void FGameSettingFilterState::AddSettingToRootList(UGameSetting* InSetting)
 {
 	SettingAllowList.Add(InSetting);
 	SettingRootList.Add(InSetting);
+
+	RefreshIndexedAllowList();
 }
 
 void FGameSettingFilterState::AddSettingToAllowList(UGameSetting* InSetting)
 {
 	SettingAllowList.Add(InSetting);
+
+	RefreshIndexedAllowList();
 }
 
 void FGameSettingFilterState::SetSearchText(const FString& InSearchText)
 {
 	SearchTextEvaluator.SetFilterText(FText::FromString(InSearchText));
+
+	RefreshIndexedSearchMatches();
+}
+
+void FGameSettingFilterState::SetSearchIndex(const TSharedPtr<const FGameSettingSearchIndex>& InSearchIndex)
+{
+	SearchIndex = InSearchIndex;
+
+	RefreshIndexedAllowList();
+	RefreshIndexedSearchMatches();
+}
+
+void FGameSettingFilterState::RefreshIndexedAllowList()
+{
+	if (SearchIndex.IsValid())
+	{
+		SearchIndex->GatherAllowedSettings(SettingAllowList, IndexedAllowedSettings);
+	}
+	else
+	{
+		IndexedAllowedSettings.Empty();
+	}
+}
+
+void FGameSettingFilterState::RefreshIndexedSearchMatches()
+{
+	if (SearchIndex.IsValid())
+	{
+		SearchIndex->GatherSearchMatches(SearchTextEvaluator, IndexedSearchMatches);
+	}
+	else
+	{
+		IndexedSearchMatches.Empty();
+	}
 }
 
 bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSetting) const
@@ -71,10 +312,19 @@ bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSettin
 		return false;
 	}
 
+	const int32 IndexedSettingIndex = SearchIndex.IsValid() ? SearchIndex->FindSettingIndex(&InSetting) : INDEX_NONE;
+
 	// Are we filtering settings?
 	if (SettingAllowList.Num() > 0)
 	{
-		if (!SettingAllowList.Contains(&InSetting))
+		if (IndexedSettingIndex != INDEX_NONE)
+		{
+			if (!IndexedAllowedSettings[IndexedSettingIndex])
+			{
+				return false;
+			}
+		}
+		else if (!SettingAllowList.Contains(&InSetting))
 		{
 			bool bAllowed = false;
 			const UGameSetting* NextSetting = &InSetting;
@@ -99,7 +349,14 @@ bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSettin
 	// TODO more filters...
 
 	// Always search text last, it's generally the most expensive filter.
-	if (!SearchTextEvaluator.TestTextFilter(FSettingFilterExpressionContext(InSetting)))
+	if (IndexedSettingIndex != INDEX_NONE)
+	{
+		if (!IndexedSearchMatches[IndexedSettingIndex])
+		{
+			return false;
+		}
+	}
+	else if (!SearchTextEvaluator.TestTextFilter(FSettingFilterExpressionContext(InSetting)))
 	{
 		return false;
 	}
@@ -148,5 +405,28 @@ void FGameSettingEditableState::UnableToReset()
 	bResetable = false;
 }
 
+bool FGameSettingEditableState::operator==(const FGameSettingEditableState& Other) const
+{
+	if (bVisible != Other.bVisible ||
+		bEnabled != Other.bEnabled ||
+		bResetable != Other.bResetable ||
+		bHideFromAnalytics != Other.bHideFromAnalytics ||
+		DisabledOptions != Other.DisabledOptions ||
+		DisabledReasons.Num() != Other.DisabledReasons.Num())
+	{
+		return false;
+	}
+
+	for (int32 ReasonIndex = 0; ReasonIndex < DisabledReasons.Num(); ReasonIndex++)
+	{
+		if (!DisabledReasons[ReasonIndex].EqualTo(Other.DisabledReasons[ReasonIndex]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 #undef LOCTEXT_NAMESPACE
 
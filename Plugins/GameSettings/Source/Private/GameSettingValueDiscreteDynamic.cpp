@@ -39,6 +39,8 @@ void UGameSettingValueDiscreteDynamic::AddDynamicOption(FString InOptionValue, F
 
 	OptionValues.Add(InOptionValue);
 	OptionDisplayTexts.Add(InOptionText);
+
+	RefreshOptionIntValues();
 }
 
 void UGameSettingValueDiscreteDynamic::RemoveDynamicOption(FString InOptionValue)
@@ -48,6 +50,34 @@ void UGameSettingValueDiscreteDynamic::RemoveDynamicOption(FString InOptionValue
 	{
 		OptionValues.RemoveAt(Index);
 		OptionDisplayTexts.RemoveAt(Index);
+
+		RefreshOptionIntValues();
+	}
+}
+
+void UGameSettingValueDiscreteDynamic::RefreshOptionIntValues()
+{
+	OptionIntValues.Reset(OptionValues.Num());
+
+	for (const FString& OptionValue : OptionValues)
+	{
+		int64 IntValue = 0;
+		if (OptionValue == TEXT("true") || OptionValue == TEXT("false"))
+		{
+			IntValue = OptionValue == TEXT("true") ? 1 : 0;
+		}
+		else if (!OptionValue.IsNumeric() || OptionValue.Contains(TEXT(".")))
+		{
+			// Any option that isn't a plain integer means the options have to be compared as strings
+			OptionIntValues.Reset();
+			return;
+		}
+		else
+		{
+			LexFromString(IntValue, *OptionValue);
+		}
+
+		OptionIntValues.Add(IntValue);
 	}
 }
 
@@ -86,11 +116,15 @@ bool UGameSettingValueDiscreteDynamic::AreOptionsEqual(const FString& InOptionA,
 
 void UGameSettingValueDiscreteDynamic::OnInitialized()
 {
+	// Resolve once up front, so reads and writes go through the cached property chain
+	const bool bGetterResolved = Getter && Getter->Resolve(LocalPlayer);
+	const bool bSetterResolved = Setter && Setter->Resolve(LocalPlayer);
+
 #if !UE_BUILD_SHIPPING
 	ensureAlways(Getter);
-	ensureAlwaysMsgf(Getter->Resolve(LocalPlayer), TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties? Does the getter function have no parameters?"), *GetDevName().ToString(), *Getter->ToString());
+	ensureAlwaysMsgf(bGetterResolved, TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties? Does the getter function have no parameters?"), *GetDevName().ToString(), *Getter->ToString());
 	ensureAlways(Setter);
-	ensureAlwaysMsgf(Setter->Resolve(LocalPlayer), TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties? Does the setting function have exactly one parameter?"), *GetDevName().ToString(), *Setter->ToString());
+	ensureAlwaysMsgf(bSetterResolved, TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties? Does the setting function have exactly one parameter?"), *GetDevName().ToString(), *Setter->ToString());
 #endif
 
 	Super::OnInitialized();
@@ -130,16 +164,33 @@ void UGameSettingValueDiscreteDynamic::SetDiscreteOptionByIndex(int32 Index)
 {
 	if (ensure(OptionValues.IsValidIndex(Index)))
 	{
+		check(Setter);
+		if (OptionIntValues.IsValidIndex(Index) && Setter->SetValueFromInt(LocalPlayer, OptionIntValues[Index]))
+		{
+			NotifySettingChanged(EGameSettingChangeReason::Change);
+			return;
+		}
+
 		SetValueFromString(OptionValues[Index]);
 	}
 }
 
 int32 UGameSettingValueDiscreteDynamic::GetDiscreteOptionIndex() const
 {
-	const FString CurrentValue = GetValueAsString();
-	const int32 Index = OptionValues.IndexOfByPredicate([this, CurrentValue](const FString& InOption) {
-		return AreOptionsEqual(CurrentValue, InOption);
-	});
+	int32 Index = INDEX_NONE;
+
+	int64 CurrentIntValue = 0;
+	if (OptionIntValues.Num() > 0 && Getter->GetValueAsInt(LocalPlayer, CurrentIntValue))
+	{
+		Index = OptionIntValues.IndexOfByKey(CurrentIntValue);
+	}
+	else
+	{
+		const FString CurrentValue = GetValueAsString();
+		Index = OptionValues.IndexOfByPredicate([this, CurrentValue](const FString& InOption) {
+			return AreOptionsEqual(CurrentValue, InOption);
+		});
+	}
 
 	// If we can't find the correct index, send the default index.
 	if (Index == INDEX_NONE)
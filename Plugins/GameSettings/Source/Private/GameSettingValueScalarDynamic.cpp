@@ -95,11 +95,15 @@ void UGameSettingValueScalarDynamic::OnInitialized()
 	ensureAlwaysMsgf(DisplayFormat, TEXT("%s: Has no DisplayFormat set.  Please call SetDisplayFormat."), *GetDevName().ToString());
 #endif
 
+	// Resolve once up front, so reads and writes go through the cached property chain
+	const bool bGetterResolved = Getter && Getter->Resolve(LocalPlayer);
+	const bool bSetterResolved = Setter && Setter->Resolve(LocalPlayer);
+
 #if !UE_BUILD_SHIPPING
 	ensureAlways(Getter);
-	ensureAlwaysMsgf(Getter->Resolve(LocalPlayer), TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties?"), *GetDevName().ToString(), *Getter->ToString());
+	ensureAlwaysMsgf(bGetterResolved, TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties?"), *GetDevName().ToString(), *Getter->ToString());
 	ensureAlways(Setter);
-	ensureAlwaysMsgf(Setter->Resolve(LocalPlayer), TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties?"), *GetDevName().ToString(), *Setter->ToString());
+	ensureAlwaysMsgf(bSetterResolved, TEXT("%s: %s did not resolve, are all functions and properties valid, and are they UFunctions/UProperties?"), *GetDevName().ToString(), *Setter->ToString());
 #endif
 
 	Super::OnInitialized();
@@ -161,9 +165,13 @@ void UGameSettingValueScalarDynamic::SetMaximumLimit(const TOptional<double>& In
 
 double UGameSettingValueScalarDynamic::GetValue() const
 {
-	const FString OutValue = Getter->GetValueAsString(LocalPlayer);
-
 	double Value;
+	if (Getter->GetValueAsDouble(LocalPlayer, Value))
+	{
+		return Value;
+	}
+
+	const FString OutValue = Getter->GetValueAsString(LocalPlayer);
 	LexFromString(Value, *OutValue);
 
 	return Value;
@@ -199,8 +207,11 @@ void UGameSettingValueScalarDynamic::SetValue(double InValue, EGameSettingChange
 		InValue = FMath::Min(Maximum.GetValue(), InValue);
 	}
 
-	const FString StringValue = LexToString(InValue);
-	Setter->SetValue(LocalPlayer, StringValue);
+	if (!Setter->SetValueFromDouble(LocalPlayer, InValue))
+	{
+		const FString StringValue = LexToString(InValue);
+		Setter->SetValue(LocalPlayer, StringValue);
+	}
 
 	NotifySettingChanged(Reason);
 }
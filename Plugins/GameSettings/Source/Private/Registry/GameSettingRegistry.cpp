@@ -4,12 +4,35 @@
 
 #include "GameSettingCollection.h"
 #include "GameSettingAction.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Tasks/Task.h"
 #include "UObject/WeakObjectPtr.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameSettingRegistry)
 
 #define LOCTEXT_NAMESPACE "GameSetting"
 
+namespace GameSettingsConsoleVars
+{
+	static float RegistryBuildBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarRegistryBuildBudgetMs(
+		TEXT("GameSettings.RegistryBuildBudgetMs"),
+		RegistryBuildBudgetMs,
+		TEXT("Game thread time per frame that asynchronously initializing settings registries can spend on build steps, at least one step always runs"),
+		ECVF_Default);
+}
+
+namespace GameSettingRegistryPrivate
+{
+	/** The last background config save of any registry, the next one waits for it. */
+	static UE::Tasks::FTask PendingConfigSaveTask;
+
+	static FDelegateHandle FlushConfigSavesOnExitHandle;
+}
+
 //--------------------------------------
 // UGameSettingRegistry
 //--------------------------------------
@@ -18,39 +41,228 @@ UGameSettingRegistry::UGameSettingRegistry()
 {
 }
 
+void UGameSettingRegistry::BeginDestroy()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(BuildTickHandle);
+	BuildTickHandle.Reset();
+
+	// Don't leave a config file half written
+	FlushPendingConfigSaves();
+
+	Super::BeginDestroy();
+}
+
 void UGameSettingRegistry::Initialize(ULocalPlayer* InLocalPlayer)
 {
+	// Already initialized, e.g. prebuilt with InitializeAsync, so only finish whatever is left of the build
+	if (bInitializeStarted)
+	{
+		ensureMsgf(OwningLocalPlayer == InLocalPlayer, TEXT("Settings registry %s was already initialized for another local player"), *GetName());
+		if (IsBuilding())
+		{
+			FlushBuild();
+		}
+		return;
+	}
+
+	bInitializeStarted = true;
 	OwningLocalPlayer = InLocalPlayer;
+	BuildSteps.Reset();
+	NextBuildStepIndex = 0;
+
 	OnInitialize(InLocalPlayer);
 
+	FlushBuild();
+
 	//UGameFeaturesSubsystem
 }
 
+void UGameSettingRegistry::InitializeAsync(ULocalPlayer* InLocalPlayer)
+{
+	// Already initialized or building, a build in progress keeps going on its ticker
+	if (bInitializeStarted)
+	{
+		ensureMsgf(OwningLocalPlayer == InLocalPlayer, TEXT("Settings registry %s was already initialized for another local player"), *GetName());
+		return;
+	}
+
+	bInitializeStarted = true;
+	OwningLocalPlayer = InLocalPlayer;
+	BuildSteps.Reset();
+	NextBuildStepIndex = 0;
+
+	OnInitialize(InLocalPlayer);
+
+	if (IsBuilding())
+	{
+		if (!BuildTickHandle.IsValid())
+		{
+			BuildTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickBuild));
+		}
+	}
+	else
+	{
+		FinishBuild();
+	}
+}
+
+void UGameSettingRegistry::FlushBuild()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(BuildTickHandle);
+	BuildTickHandle.Reset();
+
+	while (IsBuilding())
+	{
+		RunBuildStep(NextBuildStepIndex++);
+	}
+
+	FinishBuild();
+}
+
+bool UGameSettingRegistry::TickBuild(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UGameSettingRegistry_TickBuild);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = GameSettingsConsoleVars::RegistryBuildBudgetMs / 1000.0;
+
+	// Always run at least one step so the build can't stall
+	do
+	{
+		RunBuildStep(NextBuildStepIndex++);
+	}
+	while (IsBuilding() && (FPlatformTime::Seconds() - StartTime) < BudgetSeconds);
+
+	if (IsBuilding())
+	{
+		return true;
+	}
+
+	BuildTickHandle.Reset();
+	FinishBuild();
+
+	return false;
+}
+
+void UGameSettingRegistry::AddBuildStep(FName StepName, TFunction<void()> BuildFunction, TFunction<uint32()> GetInputsHash)
+{
+#if !UE_BUILD_SHIPPING
+	ensureAlwaysMsgf(!BuildSteps.ContainsByPredicate([StepName](const FBuildStep& Step) { return Step.StepName == StepName; }), TEXT("A build step named %s has already been added!"), *StepName.ToString());
+#endif
+
+	FBuildStep& NewStep = BuildSteps.AddDefaulted_GetRef();
+	NewStep.StepName = StepName;
+	NewStep.BuildFunction = MoveTemp(BuildFunction);
+	NewStep.GetInputsHash = MoveTemp(GetInputsHash);
+}
+
+void UGameSettingRegistry::RunBuildStep(int32 StepIndex)
+{
+	FBuildStep& Step = BuildSteps[StepIndex];
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UGameSettingRegistry_RunBuildStep);
+
+	// When rerunning a step, its new settings take the place of the old ones
+	int32 InsertIndex = INDEX_NONE;
+	if (Step.StepTopLevelSettings.Num() > 0)
+	{
+		InsertIndex = TopLevelSettings.IndexOfByKey(Step.StepTopLevelSettings[0]);
+
+		for (UGameSetting* OldSetting : Step.StepTopLevelSettings)
+		{
+			TopLevelSettings.RemoveSingle(OldSetting);
+			UnregisterInnerSettings(OldSetting);
+		}
+		Step.StepTopLevelSettings.Reset();
+	}
+
+	{
+		TGuardValue<int32> RunningStepGuard(RunningBuildStepIndex, StepIndex);
+		Step.BuildFunction();
+	}
+
+	// The step may have added more steps, don't use the reference from before
+	FBuildStep& RanStep = BuildSteps[StepIndex];
+	RanStep.InputsHash = RanStep.GetInputsHash ? RanStep.GetInputsHash() : 0;
+
+	if (InsertIndex != INDEX_NONE)
+	{
+		for (UGameSetting* NewSetting : RanStep.StepTopLevelSettings)
+		{
+			TopLevelSettings.RemoveSingle(NewSetting);
+		}
+		TopLevelSettings.Insert(RanStep.StepTopLevelSettings, FMath::Min(InsertIndex, TopLevelSettings.Num()));
+	}
+}
+
+void UGameSettingRegistry::FinishBuild()
+{
+	RebuildSearchIndex();
+	RebuildEditDependencyGraph();
+
+	OnBuildCompleteEvent.Broadcast(this);
+}
+
 void UGameSettingRegistry::Regenerate()
 {
+	if (BuildSteps.Num() > 0)
+	{
+		FlushBuild();
+
+		bool bAnyStepRan = false;
+		for (int32 StepIndex = 0; StepIndex < BuildSteps.Num(); StepIndex++)
+		{
+			const FBuildStep& Step = BuildSteps[StepIndex];
+			if (!Step.GetInputsHash || Step.GetInputsHash() != Step.InputsHash)
+			{
+				RunBuildStep(StepIndex);
+				bAnyStepRan = true;
+			}
+		}
+
+		if (bAnyStepRan)
+		{
+			FinishBuild();
+		}
+		return;
+	}
+
 	for (UGameSetting* Setting : RegisteredSettings)
 	{
+		Setting->OnSettingReadyEvent.RemoveAll(this);
 		Setting->MarkAsGarbage();
 	}
 	RegisteredSettings.Reset();
+	RegisteredSettingsByDevName.Reset();
 	TopLevelSettings.Reset();
+	NumSettingsPendingReady = 0;
+	EditDependentsBySetting.Reset();
+	EditDependentsBySignal.Reset();
+	bEditDependencyGraphDirty = true;
+
+	BuildSteps.Reset();
+	NextBuildStepIndex = 0;
 
 	OnInitialize(OwningLocalPlayer);
+
+	FlushBuild();
 }
 
-bool UGameSettingRegistry::IsFinishedInitializing() const
+void UGameSettingRegistry::RegenerateBuildStep(FName StepName)
 {
-	bool bReady = true;
-	for (UGameSetting* Setting : RegisteredSettings)
+	FlushBuild();
+
+	const int32 StepIndex = BuildSteps.IndexOfByPredicate([StepName](const FBuildStep& Step) { return Step.StepName == StepName; });
+	if (ensureMsgf(StepIndex != INDEX_NONE, TEXT("No build step named %s"), *StepName.ToString()))
 	{
-		if (!Setting->IsReady())
-		{
-			bReady = false;
-			break;
-		}
+		RunBuildStep(StepIndex);
+		FinishBuild();
 	}
+}
 
-	return bReady;
+bool UGameSettingRegistry::IsFinishedInitializing() const
+{
+	return !IsBuilding() && NumSettingsPendingReady == 0;
 }
 
 void UGameSettingRegistry::SaveChanges()
@@ -58,8 +270,109 @@ void UGameSettingRegistry::SaveChanges()
 
 }
 
-void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings)
+void UGameSettingRegistry::BeginApplyTransaction()
+{
+	ApplyTransactionDepth++;
+}
+
+void UGameSettingRegistry::EndApplyTransaction()
+{
+	if (!ensure(ApplyTransactionDepth > 0))
+	{
+		return;
+	}
+
+	ApplyTransactionDepth--;
+	if (ApplyTransactionDepth == 0 && AppliedSettingsByGroup.Num() > 0)
+	{
+		const TMap<FName, TArray<UGameSetting*>> AppliedSettings = MoveTemp(AppliedSettingsByGroup);
+		AppliedSettingsByGroup.Reset();
+
+		OnApplyTransactionComplete(AppliedSettings);
+	}
+}
+
+void UGameSettingRegistry::SaveConfigFileInBackground(const FString& ConfigFilename)
 {
+	FConfigFile* ConfigFile = GConfig ? GConfig->Find(ConfigFilename) : nullptr;
+	if (ConfigFile == nullptr || !ConfigFile->Dirty || ConfigFile->NoSave)
+	{
+		return;
+	}
+
+	// Generating the text needs the config system, only the file write moves off the game thread
+	FString ConfigText;
+	if (!ConfigFile->WriteToString(ConfigText, ConfigFilename))
+	{
+		// A queued write of this file must not land after the synchronous one
+		FlushPendingConfigSaves();
+		GConfig->Flush(false, ConfigFilename);
+		return;
+	}
+
+	// The config system won't write the file again at exit now, so make sure the engine waits for us instead
+	ConfigFile->Dirty = false;
+	if (!GameSettingRegistryPrivate::FlushConfigSavesOnExitHandle.IsValid())
+	{
+		GameSettingRegistryPrivate::FlushConfigSavesOnExitHandle = FCoreDelegates::OnPreExit.AddStatic(&UGameSettingRegistry::FlushPendingConfigSaves);
+	}
+
+	auto WriteConfigFile = [ConfigText = MoveTemp(ConfigText), ConfigFilename]()
+	{
+		FFileHelper::SaveStringToFile(ConfigText, *ConfigFilename);
+	};
+
+	UE::Tasks::FTask& PendingConfigSaveTask = GameSettingRegistryPrivate::PendingConfigSaveTask;
+	if (PendingConfigSaveTask.IsValid())
+	{
+		PendingConfigSaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteConfigFile), UE::Tasks::Prerequisites(PendingConfigSaveTask));
+	}
+	else
+	{
+		PendingConfigSaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteConfigFile));
+	}
+}
+
+void UGameSettingRegistry::FlushPendingConfigSaves()
+{
+	check(IsInGameThread());
+
+	UE::Tasks::FTask& PendingConfigSaveTask = GameSettingRegistryPrivate::PendingConfigSaveTask;
+	if (PendingConfigSaveTask.IsValid())
+	{
+		PendingConfigSaveTask.Wait();
+		PendingConfigSaveTask = UE::Tasks::FTask();
+	}
+}
+
+void UGameSettingRegistry::RebuildSearchIndex()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UGameSettingRegistry_RebuildSearchIndex);
+
+	if (!SearchIndex.IsValid())
+	{
+		SearchIndex = MakeShared<FGameSettingSearchIndex>();
+	}
+
+	SearchIndex->Build(RegisteredSettings);
+	bSearchIndexDirty = false;
+}
+
+void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& InFilterState, TArray<UGameSetting*>& InOutSettings)
+{
+	if (bSearchIndexDirty)
+	{
+		RebuildSearchIndex();
+	}
+	else
+	{
+		SearchIndex->RefreshChangedSettings();
+	}
+
+	// Resolve the allow list and search text against the index once, instead of once per setting
+	FGameSettingFilterState FilterState = InFilterState;
+	FilterState.SetSearchIndex(SearchIndex);
+
 	TArray<UGameSetting*> RootSettings;
 	if (FilterState.GetSettingRootList().Num() > 0)
 	{
@@ -88,15 +401,8 @@ void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& F
 
 UGameSetting* UGameSettingRegistry::FindSettingByDevName(const FName& SettingDevName)
 {
-	for (UGameSetting* Setting : RegisteredSettings)
-	{
-		if (Setting->GetDevName() == SettingDevName)
-		{
-			return Setting;
-		}
-	}
-
-	return nullptr;
+	const TObjectPtr<UGameSetting>* Setting = RegisteredSettingsByDevName.Find(SettingDevName);
+	return Setting ? Setting->Get() : nullptr;
 }
 
 void UGameSettingRegistry::RegisterSetting(UGameSetting* InSetting)
@@ -104,6 +410,11 @@ void UGameSettingRegistry::RegisterSetting(UGameSetting* InSetting)
 	if (InSetting)
 	{
 		TopLevelSettings.Add(InSetting);
+		if (BuildSteps.IsValidIndex(RunningBuildStepIndex))
+		{
+			BuildSteps[RunningBuildStepIndex].StepTopLevelSettings.Add(InSetting);
+		}
+
 		InSetting->SetRegistry(this);
 		RegisterInnerSettings(InSetting);
 	}
@@ -115,6 +426,13 @@ void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 	InSetting->OnSettingAppliedEvent.AddUObject(this, &ThisClass::HandleSettingApplied);
 	InSetting->OnSettingEditConditionChangedEvent.AddUObject(this, &ThisClass::HandleSettingEditConditionsChanged);
 
+	// Count the settings still starting up, instead of asking every setting whether it's ready
+	if (!InSetting->IsReady())
+	{
+		InSetting->OnSettingReadyEvent.AddUObject(this, &ThisClass::HandleSettingReady);
+		NumSettingsPendingReady++;
+	}
+
 	// Not a fan of this, but it makes sense to aggregate action events for simplicity.
 	if (UGameSettingAction* ActionSetting = Cast<UGameSettingAction>(InSetting))
 	{
@@ -126,12 +444,22 @@ void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 		NewPageCollection->OnExecuteNavigationEvent.AddUObject(this, &ThisClass::HandleSettingNavigation);
 	}
 
+	const TObjectPtr<UGameSetting>* ExistingSetting = RegisteredSettingsByDevName.Find(InSetting->GetDevName());
+
 #if !UE_BUILD_SHIPPING
-	ensureAlwaysMsgf(!RegisteredSettings.Contains(InSetting), TEXT("This setting has already been registered!"));
-	ensureAlwaysMsgf(nullptr == RegisteredSettings.FindByPredicate([&InSetting](UGameSetting* ExistingSetting) { return InSetting->GetDevName() == ExistingSetting->GetDevName(); }), TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
+	ensureAlwaysMsgf(ExistingSetting == nullptr || *ExistingSetting != InSetting, TEXT("This setting has already been registered!"));
+	ensureAlwaysMsgf(ExistingSetting == nullptr || *ExistingSetting == InSetting, TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
 #endif
 
+	// Like the old linear search, lookups find the first setting registered with a DevName
+	if (ExistingSetting == nullptr)
+	{
+		RegisteredSettingsByDevName.Add(InSetting->GetDevName(), InSetting);
+	}
+
 	RegisteredSettings.Add(InSetting);
+	bSearchIndexDirty = true;
+	bEditDependencyGraphDirty = true;
 
 	for (UGameSetting* ChildSetting : InSetting->GetChildSettings())
 	{
@@ -139,19 +467,149 @@ void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 	}
 }
 
+void UGameSettingRegistry::UnregisterInnerSettings(UGameSetting* InSetting)
+{
+	for (UGameSetting* ChildSetting : InSetting->GetChildSettings())
+	{
+		UnregisterInnerSettings(ChildSetting);
+	}
+
+	InSetting->OnSettingChangedEvent.RemoveAll(this);
+	InSetting->OnSettingAppliedEvent.RemoveAll(this);
+	InSetting->OnSettingEditConditionChangedEvent.RemoveAll(this);
+
+	if (InSetting->OnSettingReadyEvent.IsBoundToObject(this))
+	{
+		InSetting->OnSettingReadyEvent.RemoveAll(this);
+		NumSettingsPendingReady--;
+	}
+
+	if (UGameSettingAction* ActionSetting = Cast<UGameSettingAction>(InSetting))
+	{
+		ActionSetting->OnExecuteNamedActionEvent.RemoveAll(this);
+	}
+	else if (UGameSettingCollectionPage* PageCollection = Cast<UGameSettingCollectionPage>(InSetting))
+	{
+		PageCollection->OnExecuteNavigationEvent.RemoveAll(this);
+	}
+
+	RegisteredSettings.RemoveSingle(InSetting);
+	bEditDependencyGraphDirty = true;
+	const TObjectPtr<UGameSetting>* IndexedSetting = RegisteredSettingsByDevName.Find(InSetting->GetDevName());
+	if (IndexedSetting && *IndexedSetting == InSetting)
+	{
+		RegisteredSettingsByDevName.Remove(InSetting->GetDevName());
+	}
+	bSearchIndexDirty = true;
+
+	InSetting->MarkAsGarbage();
+}
+
 void UGameSettingRegistry::HandleSettingApplied(UGameSetting* Setting)
 {
+	if (IsApplyingTransaction())
+	{
+		AppliedSettingsByGroup.FindOrAdd(Setting->GetApplyGroup()).AddUnique(Setting);
+	}
+
 	OnSettingApplied(Setting);
 }
 
+void UGameSettingRegistry::RebuildEditDependencyGraph()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UGameSettingRegistry_RebuildEditDependencyGraph);
+
+	EditDependentsBySetting.Reset();
+	EditDependentsBySignal.Reset();
+
+	TArray<FName> SettingDevNames;
+	TArray<FName> SignalNames;
+	for (UGameSetting* Setting : RegisteredSettings)
+	{
+		for (const TSharedRef<FGameSettingEditCondition>& EditCondition : Setting->GetEditConditions())
+		{
+			SettingDevNames.Reset();
+			SignalNames.Reset();
+			EditCondition->GatherDependencies(SettingDevNames, SignalNames);
+
+			for (const FName& DependencyDevName : SettingDevNames)
+			{
+				UGameSetting* DependencySetting = FindSettingByDevName(DependencyDevName);
+
+#if !UE_BUILD_SHIPPING
+				ensureAlwaysMsgf(DependencySetting, TEXT("%s: An edit condition depends on %s, which isn't registered."), *Setting->GetDevName().ToString(), *DependencyDevName.ToString());
+#endif
+
+				if (DependencySetting && DependencySetting != Setting)
+				{
+					EditDependentsBySetting.FindOrAdd(DependencySetting).AddUnique(Setting);
+				}
+			}
+
+			for (const FName& SignalName : SignalNames)
+			{
+				EditDependentsBySignal.FindOrAdd(SignalName).AddUnique(Setting);
+			}
+		}
+	}
+
+	bEditDependencyGraphDirty = false;
+}
+
+void UGameSettingRegistry::RefreshEditDependents(const TArray<UGameSetting*>& Dependents)
+{
+	// Dependents whose state changes notify, which reaches their own dependents through HandleSettingEditConditionsChanged
+	for (UGameSetting* Dependent : TArray<UGameSetting*>(Dependents))
+	{
+		Dependent->RefreshEditableStateIfChanged();
+	}
+}
+
+void UGameSettingRegistry::RefreshEditDependentsOf(UGameSetting* Setting)
+{
+	// Settings still being registered get their editable state when they finish initializing
+	if (IsBuilding())
+	{
+		return;
+	}
+
+	if (bEditDependencyGraphDirty)
+	{
+		RebuildEditDependencyGraph();
+	}
+
+	if (const TArray<UGameSetting*>* Dependents = EditDependentsBySetting.Find(Setting))
+	{
+		RefreshEditDependents(*Dependents);
+	}
+}
+
+void UGameSettingRegistry::NotifyEditConditionSignalChanged(FName SignalName)
+{
+	if (bEditDependencyGraphDirty)
+	{
+		RebuildEditDependencyGraph();
+	}
+
+	if (const TArray<UGameSetting*>* Dependents = EditDependentsBySignal.Find(SignalName))
+	{
+		RefreshEditDependents(*Dependents);
+	}
+}
+
 void UGameSettingRegistry::HandleSettingChanged(UGameSetting* Setting, EGameSettingChangeReason Reason)
 {
 	OnSettingChangedEvent.Broadcast(Setting, Reason);
+
+	// Only the settings that read this one need their editable state recomputed
+	RefreshEditDependentsOf(Setting);
 }
 
 void UGameSettingRegistry::HandleSettingEditConditionsChanged(UGameSetting* Setting)
 {
 	OnSettingEditConditionChangedEvent.Broadcast(Setting);
+
+	RefreshEditDependentsOf(Setting);
 }
 
 void UGameSettingRegistry::HandleSettingNamedAction(UGameSetting* Setting, FGameplayTag GameSettings_Action_Tag)
@@ -164,5 +622,11 @@ void UGameSettingRegistry::HandleSettingNavigation(UGameSetting* Setting)
 	OnExecuteNavigationEvent.Broadcast(Setting);
 }
 
+void UGameSettingRegistry::HandleSettingReady(UGameSetting* Setting)
+{
+	Setting->OnSettingReadyEvent.RemoveAll(this);
+	NumSettingsPendingReady--;
+}
+
 #undef LOCTEXT_NAMESPACE
 
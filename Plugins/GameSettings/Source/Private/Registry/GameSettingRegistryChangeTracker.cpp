@@ -7,6 +7,8 @@
 
 #define LOCTEXT_NAMESPACE "GameSetting"
 
+DEFINE_LOG_CATEGORY_STATIC(LogGameSettingChangeTracker, Log, All);
+
 FGameSettingRegistryChangeTracker::FGameSettingRegistryChangeTracker()
 {
 }
@@ -54,16 +56,47 @@ void FGameSettingRegistryChangeTracker::ClearDirtyState()
 
 void FGameSettingRegistryChangeTracker::ApplyChanges()
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FGameSettingRegistryChangeTracker_ApplyChanges);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<UGameSettingValue*> SettingsToApply;
+	SettingsToApply.Reserve(DirtySettings.Num());
 	for (auto Entry : DirtySettings)
 	{
 		if (UGameSettingValue* SettingValue = Cast<UGameSettingValue>(Entry.Value))
 		{
-			SettingValue->Apply();
-			SettingValue->StoreInitial();
+			SettingsToApply.Add(SettingValue);
 		}
 	}
 
+	// Keep settings backed by the same system together
+	SettingsToApply.StableSort([](const UGameSettingValue& A, const UGameSettingValue& B)
+	{
+		return A.GetApplyGroup().FastLess(B.GetApplyGroup());
+	});
+
+	UGameSettingRegistry* StrongRegistry = Registry.Get();
+	if (StrongRegistry)
+	{
+		StrongRegistry->BeginApplyTransaction();
+	}
+
+	for (UGameSettingValue* SettingValue : SettingsToApply)
+	{
+		SettingValue->Apply();
+		SettingValue->StoreInitial();
+	}
+
+	if (StrongRegistry)
+	{
+		StrongRegistry->EndApplyTransaction();
+	}
+
 	ClearDirtyState();
+
+	LastApplyDurationSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogGameSettingChangeTracker, Log, TEXT("Applied %d changed settings in %.2f ms"), SettingsToApply.Num(), LastApplyDurationSeconds * 1000.0);
 }
 
 void FGameSettingRegistryChangeTracker::RestoreToInitial()
@@ -85,4 +85,12 @@ void UGameSettingListView::AddNameOverride(const FName& DevName, const FText& Ov
 	NameOverrides.Add(DevName, OverrideName);
 }
 
+void UGameSettingListView::PreloadEntriesForSettings(const TArray<UGameSetting*>& InSettings)
+{
+	if (VisualData)
+	{
+		VisualData->PreloadForSettings(InSettings);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
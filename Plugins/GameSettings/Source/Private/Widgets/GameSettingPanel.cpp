@@ -74,6 +74,12 @@ void UGameSettingPanel::SetRegistry(UGameSettingRegistry* InRegistry)
 
 		RegisterRegistryEvents();
 
+		// Registries still building (see UGameSettingRegistry::InitializeAsync) are preloaded once they complete
+		if (Registry && !Registry->IsBuilding())
+		{
+			PreloadRegistryEntries();
+		}
+
 		RefreshSettingsList();
 	}
 }
@@ -85,6 +91,7 @@ void UGameSettingPanel::RegisterRegistryEvents()
 		Registry->OnSettingEditConditionChangedEvent.AddUObject(this, &ThisClass::HandleSettingEditConditionsChanged);
 		Registry->OnSettingNamedActionEvent.AddUObject(this, &ThisClass::HandleSettingNamedAction);
 		Registry->OnExecuteNavigationEvent.AddUObject(this, &ThisClass::HandleSettingNavigation);
+		Registry->OnBuildCompleteEvent.AddUObject(this, &ThisClass::HandleRegistryBuildComplete);
 	}
 }
 
@@ -95,9 +102,28 @@ void UGameSettingPanel::UnregisterRegistryEvents()
 		Registry->OnSettingEditConditionChangedEvent.RemoveAll(this);
 		Registry->OnSettingNamedActionEvent.RemoveAll(this);
 		Registry->OnExecuteNavigationEvent.RemoveAll(this);
+		Registry->OnBuildCompleteEvent.RemoveAll(this);
 	}
 }
 
+void UGameSettingPanel::HandleRegistryBuildComplete(UGameSettingRegistry* InRegistry)
+{
+	PreloadRegistryEntries();
+}
+
+void UGameSettingPanel::PreloadRegistryEntries()
+{
+	FGameSettingFilterState AllSettingsFilter;
+	AllSettingsFilter.bIncludeDisabled = true;
+	AllSettingsFilter.bIncludeHidden = true;
+	AllSettingsFilter.bIncludeNestedPages = true;
+
+	TArray<UGameSetting*> AllSettings;
+	Registry->GetSettingsForFilter(AllSettingsFilter, AllSettings);
+
+	ListView_Settings->PreloadEntriesForSettings(AllSettings);
+}
+
 void UGameSettingPanel::SetFilterState(const FGameSettingFilterState& InFilterState, bool bClearNavigationStack)
 {
 	FilterState = InFilterState;
@@ -2,7 +2,10 @@
 
 #include "Widgets/GameSettingVisualData.h"
 
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "GameSetting.h"
+#include "Widgets/GameSettingDetailExtension.h"
 #include "Widgets/GameSettingListEntry.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameSettingVisualData)
@@ -31,22 +34,75 @@ TSubclassOf<UGameSettingListEntryBase> UGameSettingVisualData::GetEntryForSettin
 	}
 
 	// Finally check to see if there's an entry for this setting following the classes we have entries for.
+	return GetEntryForSettingClass(InSetting->GetClass());
+}
+
+TSubclassOf<UGameSettingListEntryBase> UGameSettingVisualData::GetEntryForSettingClass(UClass* SettingClass)
+{
+	if (const TSubclassOf<UGameSettingListEntryBase>* CachedEntryWidgetClass = ResolvedEntryWidgetForClass.Find(SettingClass))
+	{
+		return *CachedEntryWidgetClass;
+	}
+
 	// we use the super chain of the setting classes to find the most applicable entry widget for this class
 	// of setting.
-	for (UClass* Class = InSetting->GetClass(); Class; Class = Class->GetSuperClass())
+	TSubclassOf<UGameSettingListEntryBase> EntryWidgetClass;
+	for (UClass* Class = SettingClass; Class; Class = Class->GetSuperClass())
 	{
-		if (TSubclassOf<UGameSetting> SettingClass = TSubclassOf<UGameSetting>(Class))
+		if (TSubclassOf<UGameSetting> SuperSettingClass = TSubclassOf<UGameSetting>(Class))
 		{
-			TSubclassOf<UGameSettingListEntryBase> EntryWidgetClassPtr = EntryWidgetForClass.FindRef(SettingClass);
-			if (EntryWidgetClassPtr)
+			EntryWidgetClass = EntryWidgetForClass.FindRef(SuperSettingClass);
+			if (EntryWidgetClass)
 			{
-				return EntryWidgetClassPtr;
+				break;
 			}
 		}
 	}
 
-	return TSubclassOf<UGameSettingListEntryBase>();
+	ResolvedEntryWidgetForClass.Add(SettingClass, EntryWidgetClass);
+
+	return EntryWidgetClass;
+}
+
+void UGameSettingVisualData::PreloadForSettings(const TArray<UGameSetting*>& InSettings)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UGameSettingVisualData_PreloadForSettings);
+
+	TArray<FSoftObjectPath> ExtensionPaths;
+	for (UGameSetting* Setting : InSettings)
+	{
+		if (Setting == nullptr)
+		{
+			continue;
+		}
+
+		GetEntryForSetting(Setting);
+
+		for (const TSoftClassPtr<UGameSettingDetailExtension>& SoftClassPtr : GatherDetailExtensions(Setting))
+		{
+			if (SoftClassPtr.IsPending())
+			{
+				ExtensionPaths.AddUnique(SoftClassPtr.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (ExtensionPaths.Num() > 0)
+	{
+		// Keep the previous handle alive until this one is requested, so nothing it loaded gets released in between.
+		TSharedPtr<FStreamableHandle> PreviousPreloadHandle = MoveTemp(PreloadHandle);
+		PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(ExtensionPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+#if WITH_EDITOR
+void UGameSettingVisualData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	ResolvedEntryWidgetForClass.Reset();
 }
+#endif
 
 TArray<TSoftClassPtr<UGameSettingDetailExtension>> UGameSettingVisualData::GatherDetailExtensions(UGameSetting* InSetting)
 {
@@ -27,5 +27,17 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InContext, const FString& Value) = 0;
 
+	/**
+	 * Typed access that skips the string round trip.  These return false when the data source can't provide
+	 * the value as that type, callers should then fall back to GetValueAsString / SetValue.
+	 */
+	virtual bool GetValueAsBool(ULocalPlayer* InContext, bool& OutValue) const { return false; }
+	virtual bool GetValueAsInt(ULocalPlayer* InContext, int64& OutValue) const { return false; }
+	virtual bool GetValueAsDouble(ULocalPlayer* InContext, double& OutValue) const { return false; }
+
+	virtual bool SetValueFromBool(ULocalPlayer* InContext, bool Value) { return false; }
+	virtual bool SetValueFromInt(ULocalPlayer* InContext, int64 Value) { return false; }
+	virtual bool SetValueFromDouble(ULocalPlayer* InContext, double Value) { return false; }
+
 	virtual FString ToString() const = 0;
 };
@@ -24,10 +24,42 @@ public:
 
 	UE_API virtual void SetValue(ULocalPlayer* InLocalPlayer, const FString& Value) override;
 
+	UE_API virtual bool GetValueAsBool(ULocalPlayer* InLocalPlayer, bool& OutValue) const override;
+	UE_API virtual bool GetValueAsInt(ULocalPlayer* InLocalPlayer, int64& OutValue) const override;
+	UE_API virtual bool GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const override;
+
+	UE_API virtual bool SetValueFromBool(ULocalPlayer* InLocalPlayer, bool Value) override;
+	UE_API virtual bool SetValueFromInt(ULocalPlayer* InLocalPlayer, int64 Value) override;
+	UE_API virtual bool SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value) override;
+
 	UE_API virtual FString ToString() const override;
 
+private:
+	/** The type of the property (or function return value / parameter) at the end of the path, found when it resolves */
+	enum class EValueType : uint8
+	{
+		Unknown,
+		Bool,
+		Byte,
+		Int32,
+		Int64,
+		Float,
+		Double,
+	};
+
+	static EValueType GetLeafValueType(const FCachedPropertyPath& InPath);
+
+	/** Reads the leaf as ValueType and converts it, only valid for the integer and floating point types */
+	template<typename ValueType>
+	bool GetNumericValue(ULocalPlayer* InLocalPlayer, ValueType& OutValue) const;
+
+	template<typename ValueType>
+	bool SetNumericValue(ULocalPlayer* InLocalPlayer, ValueType InValue);
+
 private:
 	FCachedPropertyPath DynamicPath;
+
+	EValueType LeafValueType = EValueType::Unknown;
 };
 
 #undef UE_API
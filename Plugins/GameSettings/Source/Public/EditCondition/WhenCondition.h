@@ -12,11 +12,31 @@ public:
 	{
 	}
 
+	/** Declares a setting the inline condition reads, so it's re-evaluated when that setting changes. */
+	FWhenCondition& DependsOnSetting(FName SettingDevName)
+	{
+		SettingDependencies.AddUnique(SettingDevName);
+		return *this;
+	}
+
+	/** Declares an external signal the inline condition reads, see UGameSettingRegistry::NotifyEditConditionSignalChanged. */
+	FWhenCondition& DependsOnSignal(FName SignalName)
+	{
+		SignalDependencies.AddUnique(SignalName);
+		return *this;
+	}
+
 	virtual void GatherEditState(const ULocalPlayer* InLocalPlayer, FGameSettingEditableState& InOutEditState) const override
 	{
 		InlineEditCondition(InLocalPlayer, InOutEditState);
 	}
 
+	virtual void GatherDependencies(TArray<FName>& OutSettingDevNames, TArray<FName>& OutSignalNames) const override
+	{
+		OutSettingDevNames.Append(SettingDependencies);
+		OutSignalNames.Append(SignalDependencies);
+	}
+
 	virtual FString ToString() const override
 	{
 		return TEXT("Inline Edit Condition");
@@ -24,4 +44,7 @@ public:
 
 private:
 	TFunction<void(const ULocalPlayer* InLocalPlayer, FGameSettingEditableState& InOutEditState)> InlineEditCondition;
+
+	TArray<FName> SettingDependencies;
+	TArray<FName> SignalDependencies;
 };
@@ -35,11 +35,15 @@ public:
 	DECLARE_EVENT_TwoParams(UGameSetting, FOnSettingChanged, UGameSetting* /*InSetting*/, EGameSettingChangeReason /*InChangeReason*/);
 	DECLARE_EVENT_OneParam(UGameSetting, FOnSettingApplied, UGameSetting* /*InSetting*/);
 	DECLARE_EVENT_OneParam(UGameSetting, FOnSettingEditConditionChanged, UGameSetting* /*InSetting*/);
+	DECLARE_EVENT_OneParam(UGameSetting, FOnSettingReady, UGameSetting* /*InSetting*/);
 
 	FOnSettingChanged OnSettingChangedEvent;
 	FOnSettingApplied OnSettingAppliedEvent;
 	FOnSettingEditConditionChanged OnSettingEditConditionChangedEvent;
 
+	/** Broadcast once the setting finished its (possibly async) startup, see IsReady. */
+	FOnSettingReady OnSettingReadyEvent;
+
 public:
 
 	/**
@@ -53,9 +57,16 @@ public:
 	bool GetAdjustListViewPostRefresh() const { return bAdjustListViewPostRefresh; }
 	void SetAdjustListViewPostRefresh(const bool Value) { bAdjustListViewPostRefresh = Value; }
 
+	/**
+	 * Settings backed by the same system (e.g. video or audio) should share an apply group, so applying changes
+	 * applies them together and the registry can do the work shared by the group once, see UGameSettingRegistry::OnApplyTransactionComplete.
+	 */
+	FName GetApplyGroup() const { return ApplyGroup; }
+	void SetApplyGroup(const FName& Value) { ApplyGroup = Value; }
+
 	UFUNCTION(BlueprintCallable)
 	FText GetDisplayName() const { return DisplayName; }
-	void SetDisplayName(const FText& Value) { DisplayName = Value; }
+	void SetDisplayName(const FText& Value) { DisplayName = Value; InvalidateSearchableText(); }
 #if !UE_BUILD_SHIPPING
 	void SetDisplayName(const FString& Value) { SetDisplayName(FText::FromString(Value)); }
 #endif
@@ -80,6 +91,9 @@ public:
 	/** Gets the searchable plain text for the description. */
 	UE_API const FString& GetDescriptionPlainText() const;
 
+	/** Changes every time the display name or description changes, so search indices know to re-read them. */
+	uint32 GetSearchableTextRevision() const { return SearchableTextRevision; }
+
 	/** Initializes the setting, giving it the owning local player.  Containers automatically initialize settings added to them. */
 	UE_API void Initialize(ULocalPlayer* InLocalPlayer);
 
@@ -147,6 +161,15 @@ public:
 	 */
 	UE_API void RefreshEditableState(bool bNotifyEditConditionsChanged = true);
 
+	/**
+	 * Like RefreshEditableState, but only notifies when the editable state actually changed, so UI showing this
+	 * setting isn't refreshed for nothing.  Returns true if it changed.
+	 */
+	UE_API bool RefreshEditableStateIfChanged();
+
+	/** The edit conditions added to this setting. */
+	const TArray<TSharedRef<FGameSettingEditCondition>>& GetEditConditions() const { return EditConditions; }
+
 	/**
 	 * We expect settings to change the live value immediately, but occasionally there are special settings
 	 * that go are immediately stored to a temporary location but we don't actually apply them until later
@@ -176,7 +199,7 @@ protected:
 
 	/** Regenerates the plain searchable text if it has been dirtied. */
 	UE_API void RefreshPlainText() const;
-	void InvalidateSearchableText() { bRefreshPlainSearchableText = true; }
+	void InvalidateSearchableText() { bRefreshPlainSearchableText = true; ++SearchableTextRevision; }
 
 	/** Notify that the setting changed */
 	UE_API void NotifySettingChanged(EGameSettingChangeReason Reason);
@@ -201,6 +224,7 @@ protected:
 	TObjectPtr<UGameSettingRegistry> OwningRegistry;
 
 	FName DevName;
+	FName ApplyGroup;
 	FText DisplayName;
 	ESlateVisibility DisplayNameVisibility = ESlateVisibility::SelfHitTestInvisible;
 	FText DescriptionRichText;
@@ -232,6 +256,8 @@ protected:
 	mutable bool bRefreshPlainSearchableText = true;
 	/** When we set the rich text for a setting, we automatically generate the plain text. */
 	mutable FString AutoGenerated_DescriptionPlainText;
+	/** Incremented whenever the searchable text is invalidated. */
+	uint32 SearchableTextRevision = 0;
 
 	/** Report as part of analytics, by default no setting reports, except GameSettingValues. */
 	bool bReportAnalytics = false;
@@ -22,6 +22,54 @@ enum class EGameSettingChangeReason : uint8
 	RestoreToInitial,
 };
 
+/**
+ * The searchable text and parent chain of every setting in a registry, prepared up front so filtering doesn't
+ * strip rich text or walk the parents of every setting on every keystroke.  Single word searches are narrowed
+ * down with a trigram index before testing the text.
+ */
+class FGameSettingSearchIndex
+{
+public:
+	UE_API void Build(const TArray<TObjectPtr<UGameSetting>>& InSettings);
+
+	/** Re-reads the text of any setting whose display name or description changed since it was indexed. */
+	UE_API void RefreshChangedSettings();
+
+	int32 Num() const { return Settings.Num(); }
+
+	int32 FindSettingIndex(const UGameSetting* InSetting) const
+	{
+		const int32* SettingIndex = SettingIndices.Find(InSetting);
+		return SettingIndex ? *SettingIndex : INDEX_NONE;
+	}
+
+	/** Sets the bit of every setting that is in the allow list or has a parent in it. */
+	UE_API void GatherAllowedSettings(const TArray<TObjectPtr<UGameSetting>>& InAllowList, TBitArray<>& OutAllowedSettings) const;
+
+	/** Sets the bit of every setting whose display name and description pass the search. */
+	UE_API void GatherSearchMatches(const FTextFilterExpressionEvaluator& InEvaluator, TBitArray<>& OutMatchingSettings) const;
+
+private:
+	void BuildTrigrams();
+
+	static uint64 MakeTrigram(const TCHAR* InChars)
+	{
+		return ((uint64)InChars[0] << 32) | ((uint64)InChars[1] << 16) | (uint64)InChars[2];
+	}
+
+	TArray<const UGameSetting*> Settings;
+	TMap<const UGameSetting*, int32> SettingIndices;
+
+	/** Index of the closest indexed parent of each setting, or INDEX_NONE. */
+	TArray<int32> ParentIndices;
+
+	TArray<FTextFilterString> SearchableTexts;
+	TArray<uint32> SearchableTextRevisions;
+
+	/** Ascending indices of the settings containing each three character sequence of their (uppercase) text. */
+	TMap<uint64, TArray<int32>> TrigramSettings;
+};
+
 /**
  * The filter state is intended to be any and all filtering we support.
  */
@@ -54,6 +102,9 @@ public:
 	UE_API void AddSettingToRootList(UGameSetting* InSetting);
 	UE_API void AddSettingToAllowList(UGameSetting* InSetting);
 
+	/** Answers the allow list and search text filters for indexed settings with a bit lookup, see UGameSettingRegistry::GetSettingsForFilter. */
+	UE_API void SetSearchIndex(const TSharedPtr<const FGameSettingSearchIndex>& InSearchIndex);
+
 	bool IsSettingInAllowList(const UGameSetting* InSetting) const
 	{
 		return SettingAllowList.Contains(InSetting);
@@ -66,8 +117,17 @@ public:
 	}
 
 private:
+	UE_API void RefreshIndexedAllowList();
+	UE_API void RefreshIndexedSearchMatches();
+
 	FTextFilterExpressionEvaluator SearchTextEvaluator;
 
+	TSharedPtr<const FGameSettingSearchIndex> SearchIndex;
+
+	/** Per setting in the search index, whether it passes the allow list / the search text. */
+	TBitArray<> IndexedAllowedSettings;
+	TBitArray<> IndexedSearchMatches;
+
 	UPROPERTY()
 	TArray<TObjectPtr<UGameSetting>> SettingRootList;
 
@@ -97,6 +157,10 @@ public:
 	bool IsHiddenFromAnalytics() const { return bHideFromAnalytics; }
 	const TArray<FText>& GetDisabledReasons() const { return DisabledReasons; }
 
+	/** True if both states would look the same to the UI (hidden reasons are ignored). */
+	UE_API bool operator==(const FGameSettingEditableState& Other) const;
+	bool operator!=(const FGameSettingEditableState& Other) const { return !(*this == Other); }
+
 #if !UE_BUILD_SHIPPING
 	const TArray<FString>& GetHiddenReasons() const { return HiddenReasons; }
 #endif
@@ -194,6 +258,14 @@ public:
 	{
 	}
 
+	/**
+	 * Declares the settings (by DevName) and external signals GatherEditState reads.  The registry uses these to only
+	 * recompute the editable state of the settings affected by a change, see UGameSettingRegistry::NotifyEditConditionSignalChanged.
+	 */
+	virtual void GatherDependencies(TArray<FName>& OutSettingDevNames, TArray<FName>& OutSignalNames) const
+	{
+	}
+
 	/** Generate useful debugging text for this edit condition.  Helpful when things don't work as expected. */
 	virtual FString ToString() const { return TEXT(""); }
 };
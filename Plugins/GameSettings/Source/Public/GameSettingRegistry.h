@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameSetting.h"
 #include "Templates/Casts.h"
 
@@ -42,21 +43,67 @@ public:
 	DECLARE_EVENT_OneParam(UGameSettingRegistry, FOnExecuteNavigation, UGameSetting* /*Setting*/);
 	FOnExecuteNavigation OnExecuteNavigationEvent;
 
+	/** All build steps have run, settings may still be finishing their async startup (see IsFinishedInitializing). */
+	DECLARE_EVENT_OneParam(UGameSettingRegistry, FOnBuildComplete, UGameSettingRegistry* /*Registry*/);
+	FOnBuildComplete OnBuildCompleteEvent;
+
 public:
 	UE_API UGameSettingRegistry();
 
+	//~UObject interface
+	UE_API virtual void BeginDestroy() override;
+	//~End of UObject interface
+
+	/** Builds the settings.  Calling it again, or after InitializeAsync, only finishes any build steps still waiting. */
 	UE_API void Initialize(ULocalPlayer* InLocalPlayer);
 
+	/**
+	 * Like Initialize, but runs the build steps added in OnInitialize over the following frames, a few at a time
+	 * (GameSettings.RegistryBuildBudgetMs).  Call it ahead of time, e.g. when the front end loads, so the settings
+	 * screen has nothing left to build when it opens.
+	 */
+	UE_API void InitializeAsync(ULocalPlayer* InLocalPlayer);
+
+	/** Runs any build steps still waiting from InitializeAsync right away. */
+	UE_API void FlushBuild();
+
+	/** True while build steps from InitializeAsync are still waiting to run. */
+	bool IsBuilding() const { return NextBuildStepIndex < BuildSteps.Num(); }
+
+	/**
+	 * Rebuilds the settings.  Registries made of build steps only rerun the steps whose inputs hash changed (or that
+	 * have none), settings registered directly in OnInitialize are kept.  Otherwise everything is rebuilt.
+	 */
 	UE_API virtual void Regenerate();
 
+	/** Reruns a single build step, replacing the settings it registered last time. */
+	UE_API void RegenerateBuildStep(FName StepName);
+
 	UE_API virtual bool IsFinishedInitializing() const;
 
 	UE_API virtual void SaveChanges();
+
+	/** Waits until every config file queued by SaveConfigFileInBackground has been written.  Also runs before the engine exits. */
+	static UE_API void FlushPendingConfigSaves();
+
+	/**
+	 * Brackets applying several settings at once (see FGameSettingRegistryChangeTracker::ApplyChanges).  Settings applied
+	 * in between are collected by apply group and handed to OnApplyTransactionComplete when the outermost transaction ends.
+	 */
+	UE_API void BeginApplyTransaction();
+	UE_API void EndApplyTransaction();
+	bool IsApplyingTransaction() const { return ApplyTransactionDepth > 0; }
 	
 	UE_API void GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings);
 
 	UE_API UGameSetting* FindSettingByDevName(const FName& SettingDevName);
 
+	/**
+	 * Recomputes the editable state of the settings whose edit conditions declared they read this signal (e.g. a
+	 * login or platform state), see FGameSettingEditCondition::GatherDependencies.
+	 */
+	UE_API void NotifyEditConditionSignalChanged(FName SignalName);
+
 	template<typename T = UGameSetting>
 	T* FindSettingByDevNameChecked(const FName& SettingDevName)
 	{
@@ -69,16 +116,85 @@ protected:
 	UE_API virtual void OnInitialize(ULocalPlayer* InLocalPlayer) PURE_VIRTUAL(, )
 
 	virtual void OnSettingApplied(UGameSetting* Setting) { }
+
+	/**
+	 * Called once per apply transaction with the settings applied in it, by apply group.  Override to do work that only
+	 * needs to happen once per batch instead of in OnSettingApplied, like reapplying scalability or the resolution.
+	 */
+	virtual void OnApplyTransactionComplete(const TMap<FName, TArray<UGameSetting*>>& InAppliedSettingsByGroup) { }
+
+	/**
+	 * Writes a config file's pending changes to disk on a background task, for use from SaveChanges.  The contents are
+	 * generated on the game thread, and saves from every registry run one after the other.  Anything that saves the same
+	 * file synchronously afterwards must call FlushPendingConfigSaves first, or the older background write could land last.
+	 */
+	UE_API void SaveConfigFileInBackground(const FString& ConfigFilename);
 	
+	/**
+	 * Adds a step that builds part of the registry, typically one top level collection, for use from OnInitialize.
+	 * Steps run in order after OnInitialize returns, and can be spread over several frames by InitializeAsync.
+	 * GetInputsHash should hash whatever the step reads to decide which settings exist, so Regenerate can skip it.
+	 */
+	UE_API void AddBuildStep(FName StepName, TFunction<void()> BuildFunction, TFunction<uint32()> GetInputsHash = nullptr);
+
 	UE_API void RegisterSetting(UGameSetting* InSetting);
 	UE_API void RegisterInnerSettings(UGameSetting* InSetting);
 
+	/** Reverses RegisterInnerSettings and marks the settings as garbage. */
+	UE_API void UnregisterInnerSettings(UGameSetting* InSetting);
+
+	/** Builds the search index over all registered settings, done when the registry initializes and again after settings are registered. */
+	UE_API void RebuildSearchIndex();
+
 	// Internal event handlers.
 	UE_API void HandleSettingChanged(UGameSetting* Setting, EGameSettingChangeReason Reason);
 	UE_API void HandleSettingApplied(UGameSetting* Setting);
 	UE_API void HandleSettingEditConditionsChanged(UGameSetting* Setting);
 	UE_API void HandleSettingNamedAction(UGameSetting* Setting, FGameplayTag GameSettings_Action_Tag);
 	UE_API void HandleSettingNavigation(UGameSetting* Setting);
+	UE_API void HandleSettingReady(UGameSetting* Setting);
+
+	/** Rebuilds which settings' edit conditions read which settings and signals. */
+	UE_API void RebuildEditDependencyGraph();
+	UE_API void RefreshEditDependents(const TArray<UGameSetting*>& Dependents);
+	UE_API void RefreshEditDependentsOf(UGameSetting* Setting);
+
+	UE_API bool TickBuild(float DeltaTime);
+	UE_API void RunBuildStep(int32 StepIndex);
+	UE_API void FinishBuild();
+
+	struct FBuildStep
+	{
+		FName StepName;
+		TFunction<void()> BuildFunction;
+		TFunction<uint32()> GetInputsHash;
+		uint32 InputsHash = 0;
+
+		/** Top level settings registered while this step ran, also referenced by TopLevelSettings. */
+		TArray<TObjectPtr<UGameSetting>> StepTopLevelSettings;
+	};
+
+	TArray<FBuildStep> BuildSteps;
+	int32 NextBuildStepIndex = 0;
+
+	/** Set by the first Initialize or InitializeAsync, later calls don't register the settings again. */
+	bool bInitializeStarted = false;
+	int32 RunningBuildStepIndex = INDEX_NONE;
+
+	FTSTicker::FDelegateHandle BuildTickHandle;
+
+	int32 ApplyTransactionDepth = 0;
+
+	/** Settings applied during the current apply transaction, by apply group. */
+	TMap<FName, TArray<UGameSetting*>> AppliedSettingsByGroup;
+
+	/** Registered settings that haven't finished their startup yet. */
+	int32 NumSettingsPendingReady = 0;
+
+	/** The settings whose edit conditions read each registered setting or external signal. */
+	TMap<UGameSetting*, TArray<UGameSetting*>> EditDependentsBySetting;
+	TMap<FName, TArray<UGameSetting*>> EditDependentsBySignal;
+	bool bEditDependencyGraphDirty = true;
 
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UGameSetting>> TopLevelSettings;
@@ -86,8 +202,16 @@ protected:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UGameSetting>> RegisteredSettings;
 
+	/** RegisteredSettings by DevName, for FindSettingByDevName and duplicate checks. */
+	UPROPERTY(Transient)
+	TMap<FName, TObjectPtr<UGameSetting>> RegisteredSettingsByDevName;
+
 	UPROPERTY(Transient)
 	TObjectPtr<ULocalPlayer> OwningLocalPlayer;
+
+	/** Shared with the filter states used on this registry, see GetSettingsForFilter. */
+	TSharedPtr<FGameSettingSearchIndex> SearchIndex;
+	bool bSearchIndexDirty = true;
 };
 
 #undef UE_API
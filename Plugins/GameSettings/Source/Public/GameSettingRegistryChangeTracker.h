@@ -25,8 +25,15 @@ public:
 	UE_API void WatchRegistry(UGameSettingRegistry* InRegistry);
 	UE_API void StopWatchingRegistry();
 
+	/**
+	 * Applies every changed setting as one transaction on the registry: settings are applied grouped by their apply
+	 * group, and the registry gets a single OnApplyTransactionComplete for the batch.
+	 */
 	UE_API void ApplyChanges();
 
+	/** How long the last ApplyChanges took. */
+	double GetLastApplyDurationSeconds() const { return LastApplyDurationSeconds; }
+
 	UE_API void RestoreToInitial();
 
 	UE_API void ClearDirtyState();
@@ -40,6 +47,8 @@ private:
 	bool bSettingsChanged = false;
 	bool bRestoringSettings = false;
 
+	double LastApplyDurationSeconds = 0.0;
+
 	TWeakObjectPtr<UGameSettingRegistry> Registry;
 	TMap<FObjectKey, TWeakObjectPtr<UGameSetting>> DirtySettings;
 };
@@ -60,6 +60,9 @@ protected:
 
 	UE_API bool AreOptionsEqual(const FString& InOptionA, const FString& InOptionB) const;
 
+	/** Rebuilds OptionIntValues after the options change */
+	UE_API void RefreshOptionIntValues();
+
 protected:
 	TSharedPtr<FGameSettingDataSource> Getter;
 	TSharedPtr<FGameSettingDataSource> Setter;
@@ -69,6 +72,9 @@ protected:
 
 	TArray<FString> OptionValues;
 	TArray<FText> OptionDisplayTexts;
+
+	/** OptionValues parsed as integers (true/false as 1/0), empty if any option isn't one, lets bool and integer settings skip string compares */
+	TArray<int64> OptionIntValues;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,7 @@
 
 class STableViewBase;
 
+class UGameSetting;
 class UGameSettingCollection;
 class ULocalPlayer;
 class UGameSettingVisualData;
@@ -27,6 +28,9 @@ public:
 
 	UE_API void AddNameOverride(const FName& DevName, const FText& OverrideName);
 
+	/** Gets the entry widgets and detail extensions for these settings ready ahead of them being listed, see UGameSettingVisualData::PreloadForSettings. */
+	UE_API void PreloadEntriesForSettings(const TArray<UGameSetting*>& InSettings);
+
 #if WITH_EDITOR
 	UE_API virtual void ValidateCompiledDefaults(IWidgetCompilerLog& InCompileLog) const override;
 #endif
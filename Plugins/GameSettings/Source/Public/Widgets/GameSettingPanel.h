@@ -76,6 +76,10 @@ protected:
 	UE_API void HandleSettingNamedAction(UGameSetting* Setting, FGameplayTag GameSettings_Action_Tag);
 	UE_API void HandleSettingNavigation(UGameSetting* Setting);
 	UE_API void HandleSettingEditConditionsChanged(UGameSetting* Setting);
+	UE_API void HandleRegistryBuildComplete(UGameSettingRegistry* InRegistry);
+
+	/** Preloads the list entries of every setting in the registry, including hidden, disabled and nested ones. */
+	UE_API void PreloadRegistryEntries();
 
 private:
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/DataAsset.h"
+#include "Templates/SharedPointer.h"
 
 #include "GameSettingVisualData.generated.h"
 
@@ -13,6 +14,7 @@ class UGameSetting;
 class UGameSettingDetailExtension;
 class UGameSettingListEntryBase;
 class UObject;
+struct FStreamableHandle;
 
 USTRUCT(BlueprintType)
 struct FGameSettingClassExtensions
@@ -49,10 +51,23 @@ public:
 	UE_API TSubclassOf<UGameSettingListEntryBase> GetEntryForSetting(UGameSetting* InSetting);
 
 	UE_API virtual TArray<TSoftClassPtr<UGameSettingDetailExtension>> GatherDetailExtensions(UGameSetting* InSetting);
+
+	/**
+	 * Resolves the entry widget class of each setting and starts loading their detail extensions in the background,
+	 * so that scrolling to (or selecting) a setting for the first time doesn't have to look up or load anything.
+	 */
+	UE_API void PreloadForSettings(const TArray<UGameSetting*>& InSettings);
+
+#if WITH_EDITOR
+	UE_API virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 	
 protected:
 	UE_API virtual TSubclassOf<UGameSettingListEntryBase> GetCustomEntryForSetting(UGameSetting* InSetting);
 
+	/** Finds the entry widget for the closest class in the super chain of SettingClass that has one, cached per setting class. */
+	UE_API TSubclassOf<UGameSettingListEntryBase> GetEntryForSettingClass(UClass* SettingClass);
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = ListEntries, meta = (AllowAbstract))
 	TMap<TSubclassOf<UGameSetting>, TSubclassOf<UGameSettingListEntryBase>> EntryWidgetForClass;
@@ -65,6 +80,13 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = Extensions)
 	TMap<FName, FGameSettingNameExtensions> ExtensionsForName;
+
+private:
+	/** EntryWidgetForClass resolved against the super chain, including setting classes that have no entry widget. */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, TSubclassOf<UGameSettingListEntryBase>> ResolvedEntryWidgetForClass;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
 };
 
 #undef UE_API
@@ -2,9 +2,12 @@
 
 #include "Players/MediaSubtitlesPlayer.h"
 
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "MediaPlayer.h"
 #include "Overlays.h"
 #include "Stats/Stats.h"
+#include "SubtitleDisplaySubsystem.h"
 #include "SubtitleManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(MediaSubtitlesPlayer)
@@ -26,12 +29,16 @@ void UMediaSubtitlesPlayer::BeginDestroy()
 void UMediaSubtitlesPlayer::Play()
 {
 	bEnabled = true;
+
+	ResetActiveCues();
 }
 
 void UMediaSubtitlesPlayer::Stop()
 {
 	bEnabled = false;
 
+	ResetActiveCues();
+
 	// Clear the movie subtitle for this object
 	FSubtitleManager::GetSubtitleManager()->SetMovieSubtitle(this, TArray<FString>());
 }
@@ -39,6 +46,121 @@ void UMediaSubtitlesPlayer::Stop()
 void UMediaSubtitlesPlayer::SetSubtitles(UOverlays* Subtitles)
 {
 	SourceSubtitles = Subtitles;
+
+	RebuildSubtitleIndex();
+}
+
+void UMediaSubtitlesPlayer::RebuildSubtitleIndex()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UMediaSubtitlesPlayer_RebuildSubtitleIndex);
+
+	IndexedSubtitles = SourceSubtitles;
+	Cues.Reset();
+	CueIndicesByEndTime.Reset();
+
+	if (SourceSubtitles)
+	{
+		for (FOverlayItem& Overlay : SourceSubtitles->GetAllOverlays())
+		{
+			// Cues that end before they start are never displayed
+			if (Overlay.StartTime < Overlay.EndTime)
+			{
+				Cues.Add({ Overlay.StartTime, Overlay.EndTime, MoveTemp(Overlay.Text) });
+			}
+		}
+
+		Cues.StableSort([](const FSubtitleCue& A, const FSubtitleCue& B) { return A.StartTime < B.StartTime; });
+
+		CueIndicesByEndTime.Reserve(Cues.Num());
+		for (int32 CueIndex = 0; CueIndex < Cues.Num(); CueIndex++)
+		{
+			CueIndicesByEndTime.Add(CueIndex);
+		}
+		CueIndicesByEndTime.StableSort([this](int32 A, int32 B) { return Cues[A].EndTime < Cues[B].EndTime; });
+	}
+
+	ResetActiveCues();
+}
+
+void UMediaSubtitlesPlayer::ResetActiveCues()
+{
+	ActiveCueIndices.Reset();
+	NextCueToStart = 0;
+	NextCueToEnd = 0;
+	LastPrefetchedCue = INDEX_NONE;
+	LastCueTime = FTimespan::MinValue();
+
+	// The text on screen may be from cues that no longer exist, or from before Stop, so replace it on the next update
+	// even if nothing is active at that time
+	bForceSubtitleUpdate = true;
+}
+
+void UMediaSubtitlesPlayer::PrefetchUpcomingCues()
+{
+	if (NextCueToStart == LastPrefetchedCue || NumCuesToPrefetch <= 0)
+	{
+		return;
+	}
+
+	LastPrefetchedCue = NextCueToStart;
+
+	UWorld* World = GetWorld();
+	USubtitleDisplaySubsystem* SubtitleDisplay = World ? UGameInstance::GetSubsystem<USubtitleDisplaySubsystem>(World->GetGameInstance()) : nullptr;
+	if (SubtitleDisplay == nullptr)
+	{
+		return;
+	}
+
+	TArray<FString> UpcomingTexts;
+	const int32 LastCueToPrefetch = FMath::Min(NextCueToStart + NumCuesToPrefetch, Cues.Num());
+	for (int32 CueIndex = NextCueToStart; CueIndex < LastCueToPrefetch; CueIndex++)
+	{
+		UpcomingTexts.Add(Cues[CueIndex].Text);
+	}
+
+	if (UpcomingTexts.Num() > 0)
+	{
+		SubtitleDisplay->PrefetchSubtitles(UpcomingTexts);
+	}
+}
+
+bool UMediaSubtitlesPlayer::UpdateActiveCues(FTimespan Time)
+{
+	const bool bRewound = Time < LastCueTime;
+	const bool bCueStarts = NextCueToStart < Cues.Num() && Cues[NextCueToStart].StartTime <= Time;
+	const bool bCueEnds = NextCueToEnd < CueIndicesByEndTime.Num() && Cues[CueIndicesByEndTime[NextCueToEnd]].EndTime <= Time;
+
+	LastCueTime = Time;
+
+	// Nothing started or ended since the last update, which is most frames
+	if (!bRewound && !bCueStarts && !bCueEnds)
+	{
+		return false;
+	}
+
+	PreviousActiveCueIndices = ActiveCueIndices;
+
+	// Playback went backwards (seek or loop), so find the active cues from the start again
+	if (bRewound)
+	{
+		ActiveCueIndices.Reset();
+		NextCueToStart = 0;
+		NextCueToEnd = 0;
+	}
+
+	// Cues are active from their start time up to (not including) their end time, like UOverlays::GetOverlaysForTime.
+	// Starting cues first means a cue that was skipped over entirely is added and removed again.
+	while (NextCueToStart < Cues.Num() && Cues[NextCueToStart].StartTime <= Time)
+	{
+		ActiveCueIndices.Add(NextCueToStart++);
+	}
+
+	while (NextCueToEnd < CueIndicesByEndTime.Num() && Cues[CueIndicesByEndTime[NextCueToEnd]].EndTime <= Time)
+	{
+		ActiveCueIndices.RemoveSingle(CueIndicesByEndTime[NextCueToEnd++]);
+	}
+
+	return ActiveCueIndices != PreviousActiveCueIndices;
 }
 
 void UMediaSubtitlesPlayer::BindToMediaPlayer(UMediaPlayer* InMediaPlayer)
@@ -55,17 +177,28 @@ void UMediaSubtitlesPlayer::Tick(float DeltaSeconds)
 		UMediaPlayer* MediaPlayerPtr = MediaPlayer.Get();
 		if (MediaPlayerPtr)
 		{
-			FTimespan CurrentTime = MediaPlayerPtr->GetTime();
-			TArray<FOverlayItem> CurrentSubtitles;
-			SourceSubtitles->GetOverlaysForTime(CurrentTime, CurrentSubtitles);
+			if (IndexedSubtitles != SourceSubtitles)
+			{
+				RebuildSubtitleIndex();
+			}
 
-			TArray<FString> SubtitlesText;
-			for (const FOverlayItem& Subtitle : CurrentSubtitles)
+			// Only hand the subtitle manager (and the subtitle displays) new text when the active cues change
+			const bool bActiveCuesChanged = UpdateActiveCues(MediaPlayerPtr->GetTime());
+			if (bActiveCuesChanged || bForceSubtitleUpdate)
 			{
-				SubtitlesText.Add(Subtitle.Text);
+				bForceSubtitleUpdate = false;
+
+				TArray<FString> SubtitlesText;
+				SubtitlesText.Reserve(ActiveCueIndices.Num());
+				for (int32 CueIndex : ActiveCueIndices)
+				{
+					SubtitlesText.Add(Cues[CueIndex].Text);
+				}
+
+				FSubtitleManager::GetSubtitleManager()->SetMovieSubtitle(this, SubtitlesText);
 			}
 
-			FSubtitleManager::GetSubtitleManager()->SetMovieSubtitle(this, SubtitlesText);
+			PrefetchUpcomingCues();
 		}
 		else
 		{
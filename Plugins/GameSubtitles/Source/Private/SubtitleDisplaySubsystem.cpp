@@ -35,7 +35,16 @@ const FSubtitleFormat& USubtitleDisplaySubsystem::GetSubtitleDisplayOptions() co
 
 void USubtitleDisplaySubsystem::SetSubtitleDisplayOptions(const FSubtitleFormat& InOptions)
 {
-	SubtitleFormat = InOptions;
-	DisplayFormatChangedEvent.Broadcast(SubtitleFormat);
+	// Every display restyles (and lays its text out again) on a format change, so only broadcast real changes
+	if (SubtitleFormat != InOptions)
+	{
+		SubtitleFormat = InOptions;
+		DisplayFormatChangedEvent.Broadcast(SubtitleFormat);
+	}
+}
+
+void USubtitleDisplaySubsystem::PrefetchSubtitles(const TArray<FString>& SubtitleTexts)
+{
+	PrefetchSubtitlesEvent.Broadcast(SubtitleTexts);
 }
 
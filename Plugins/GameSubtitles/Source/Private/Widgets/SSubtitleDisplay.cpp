@@ -2,15 +2,30 @@
 
 #include "Widgets/SSubtitleDisplay.h"
 
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Text/RichTextMarkupProcessing.h"
 #include "Kismet/GameplayStatics.h"
+#include "Rendering/SlateRenderer.h"
 #include "SubtitleManager.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Text/SRichTextBlock.h"
 
 struct FSlateBrush;
 
+namespace SubtitleDisplayPrivate
+{
+	/** Enough for the upcoming cues of a few players, forgetting older texts only means they might be measured again */
+	static constexpr int32 MaxPrefetchedSubtitles = 128;
+}
+
 void SSubtitleDisplay::Construct(const FArguments& InArgs)
 {
+	TextStyle = *InArgs._TextStyle;
+
+	// Nothing to tick, this lets invalidation panels keep us cached until the subtitle or style changes
+	SetCanTick(false);
+
 	if (!InArgs._ManualSubtitles.Get())
 	{
 		FSubtitleManagerSetSubtitleText& OnSetSubtitleText = FSubtitleManager::GetSubtitleManager()->OnSetSubtitleText();
@@ -38,6 +53,9 @@ SSubtitleDisplay::~SSubtitleDisplay()
 
 void SSubtitleDisplay::SetTextStyle(const FTextBlockStyle& InTextStyle)
 {
+	TextStyle = InTextStyle;
+	PrefetchedSubtitleHashes.Reset();
+
 	TextDisplay->SetTextStyle(InTextStyle);
 }
 
@@ -48,7 +66,7 @@ void SSubtitleDisplay::SetBackgroundBrush(const FSlateBrush* InSlateBrush)
 
 void SSubtitleDisplay::SetCurrentSubtitleText(const FText& InSubtitleText)
 {
-	Background->SetVisibility(InSubtitleText.IsEmpty() ? EVisibility::Collapsed : EVisibility::HitTestInvisible);
+	SetBackgroundVisible(!InSubtitleText.IsEmpty());
 	TextDisplay->SetText(InSubtitleText);
 }
 
@@ -62,15 +80,83 @@ void SSubtitleDisplay::SetWrapTextAt(const TAttribute<float>& InWrapTextAt)
 	TextDisplay->SetWrapTextAt(InWrapTextAt);
 }
 
+void SSubtitleDisplay::PrefetchSubtitleText(const TArray<FString>& SubtitleTexts)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SSubtitleDisplay_PrefetchSubtitleText);
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		return;
+	}
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	const TSharedRef<FDefaultRichTextMarkupParser> MarkupParser = FDefaultRichTextMarkupParser::GetStaticInstance();
+
+	TArray<FTextLineParseResults> LineResults;
+	FString ProcessedText;
+	for (const FString& SubtitleText : SubtitleTexts)
+	{
+		if (SubtitleText.IsEmpty())
+		{
+			continue;
+		}
+
+		if (PrefetchedSubtitleHashes.Num() >= SubtitleDisplayPrivate::MaxPrefetchedSubtitles)
+		{
+			PrefetchedSubtitleHashes.Reset();
+		}
+
+		bool bAlreadyPrefetched = false;
+		PrefetchedSubtitleHashes.Add(GetTypeHash(SubtitleText), &bAlreadyPrefetched);
+		if (bAlreadyPrefetched)
+		{
+			continue;
+		}
+
+		// Parse the markup like the rich text block will, so only the text that is displayed gets measured.  The block has
+		// no decorators or style set, so every run is displayed with the base text style.
+		LineResults.Reset();
+		ProcessedText.Reset();
+		MarkupParser->Process(LineResults, SubtitleText, ProcessedText);
+
+		for (const FTextLineParseResults& LineResult : LineResults)
+		{
+			for (const FTextRunParseResults& RunResult : LineResult.Runs)
+			{
+				// Untagged text only has its original range, tags without content have nothing to display
+				const FTextRange& RunRange = RunResult.Name.IsEmpty() ? RunResult.OriginalRange : RunResult.ContentRange;
+				if (!RunRange.IsEmpty())
+				{
+					FontMeasure->Measure(ProcessedText, RunRange.BeginIndex, RunRange.EndIndex, TextStyle.Font);
+				}
+			}
+		}
+	}
+}
+
+void SSubtitleDisplay::SetBackgroundVisible(bool bVisible)
+{
+	const EVisibility NewVisibility = bVisible ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	if (Background->GetVisibility() != NewVisibility)
+	{
+		Background->SetVisibility(NewVisibility);
+	}
+}
+
 void SSubtitleDisplay::HandleSubtitleChanged(const FText& InSubtitleText)
 {
 	if (UGameplayStatics::AreSubtitlesEnabled())
 	{
-		Background->SetVisibility(InSubtitleText.IsEmpty() ? EVisibility::Collapsed : EVisibility::HitTestInvisible);
-		TextDisplay->SetText(InSubtitleText);
+		SetBackgroundVisible(!InSubtitleText.IsEmpty());
+
+		// The same subtitle is often sent again as a new FText, avoid laying it out again
+		if (!TextDisplay->GetText().ToString().Equals(InSubtitleText.ToString(), ESearchCase::CaseSensitive))
+		{
+			TextDisplay->SetText(InSubtitleText);
+		}
 	}
 	else
 	{
-		Background->SetVisibility(EVisibility::Collapsed);
+		SetBackgroundVisible(false);
 	}
 }
@@ -45,6 +45,7 @@ void USubtitleDisplay::ReleaseSlateResources(bool bReleaseChildren)
 	if (USubtitleDisplaySubsystem* SubtitleDisplay = UGameInstance::GetSubsystem<USubtitleDisplaySubsystem>(GetGameInstance()))
 	{
 		SubtitleDisplay->DisplayFormatChangedEvent.RemoveAll(this);
+		SubtitleDisplay->PrefetchSubtitlesEvent.RemoveAll(this);
 	}
 }
 
@@ -53,6 +54,7 @@ TSharedRef<SWidget> USubtitleDisplay::RebuildWidget()
 	if (USubtitleDisplaySubsystem* SubtitleDisplay = UGameInstance::GetSubsystem<USubtitleDisplaySubsystem>(GetGameInstance()))
 	{
 		SubtitleDisplay->DisplayFormatChangedEvent.AddUObject(this, &ThisClass::HandleSubtitleDisplayOptionsChanged);
+		SubtitleDisplay->PrefetchSubtitlesEvent.AddUObject(this, &ThisClass::HandlePrefetchSubtitles);
 		Format = SubtitleDisplay->GetSubtitleDisplayOptions();
 	}
 
@@ -68,13 +70,21 @@ TSharedRef<SWidget> USubtitleDisplay::RebuildWidget()
 
 void USubtitleDisplay::HandleSubtitleDisplayOptionsChanged(const FSubtitleFormat& InDisplayFormat)
 {
-	if (SubtitleWidget.IsValid())
+	if (SubtitleWidget.IsValid() && Format != InDisplayFormat)
 	{
 		Format = InDisplayFormat;
 		RebuildStyle();
 	}
 }
 
+void USubtitleDisplay::HandlePrefetchSubtitles(const TArray<FString>& SubtitleTexts)
+{
+	if (SubtitleWidget.IsValid())
+	{
+		SubtitleWidget->PrefetchSubtitleText(SubtitleTexts);
+	}
+}
+
 void USubtitleDisplay::RebuildStyle()
 {
 	GeneratedStyle = FTextBlockStyle();
@@ -4,6 +4,7 @@
 
 #include "Tickable.h"
 
+#include "Misc/Timespan.h"
 #include "UObject/ObjectPtr.h"
 #include "UObject/WeakObjectPtr.h"
 #include "MediaSubtitlesPlayer.generated.h"
@@ -32,6 +33,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subtitles Source")
 	TObjectPtr<UOverlays> SourceSubtitles;
 
+	/** How many of the upcoming subtitles the subtitle displays get ready ahead of time (see USubtitleDisplaySubsystem::PrefetchSubtitles). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Subtitles Source", meta=(ClampMin=0))
+	int32 NumCuesToPrefetch = 2;
+
 public:
 
 	UE_API virtual void BeginDestroy() override;
@@ -44,7 +49,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Game Subtitles|Subtitles Player")
 	UE_API void Stop();
 
-	/** Sets the source with the new subtitles set. */
+	/** Sets the source with the new subtitles set, and indexes them for playback. */
 	UFUNCTION(BlueprintCallable, Category="Game Subtitles|Subtitles Player")
 	UE_API void SetSubtitles(UOverlays* Subtitles);
 
@@ -52,6 +57,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Game Subtitles|Subtitles Player")
 	UE_API void BindToMediaPlayer(UMediaPlayer* InMediaPlayer);
 
+	/** Rebuilds the cue index from SourceSubtitles, needed if the overlays change after they were set. */
+	UFUNCTION(BlueprintCallable, Category="Game Subtitles|Subtitles Player")
+	UE_API void RebuildSubtitleIndex();
+
 public:
 
 	//~ FTickableGameObject interface
@@ -61,6 +70,54 @@ public:
 
 private:
 
+	struct FSubtitleCue
+	{
+		FTimespan StartTime;
+		FTimespan EndTime;
+		FString Text;
+	};
+
+	/** Moves the cue cursors to Time, returns true if the set of active cues changed. */
+	bool UpdateActiveCues(FTimespan Time);
+
+	/** Clears the active cues and rewinds the cursors to the start of the subtitles. */
+	void ResetActiveCues();
+
+	/** Sends the next NumCuesToPrefetch cues to the subtitle displays, once per cue. */
+	void PrefetchUpcomingCues();
+
+private:
+
+	/** The overlays the cue index was built from */
+	TWeakObjectPtr<UOverlays> IndexedSubtitles;
+
+	/** The cues of IndexedSubtitles, sorted by start time */
+	TArray<FSubtitleCue> Cues;
+
+	/** Indices into Cues, sorted by end time */
+	TArray<int32> CueIndicesByEndTime;
+
+	/** Indices into Cues of the cues being displayed, in start time order */
+	TArray<int32> ActiveCueIndices;
+
+	/** The active cues before the last update, to tell if they changed */
+	TArray<int32> PreviousActiveCueIndices;
+
+	/** The next cue (in Cues) that will start */
+	int32 NextCueToStart = 0;
+
+	/** The next cue (in CueIndicesByEndTime) that will end */
+	int32 NextCueToEnd = 0;
+
+	/** NextCueToStart when the upcoming cues were last prefetched */
+	int32 LastPrefetchedCue = INDEX_NONE;
+
+	/** The time the active cues were last updated for */
+	FTimespan LastCueTime;
+
+	/** Set when the active cues are reset, so the next update sends the subtitle text even if the active cues match */
+	bool bForceSubtitleUpdate = false;
+
 	/** A reference to our media player */
 	TWeakObjectPtr<class UMediaPlayer> MediaPlayer;
 
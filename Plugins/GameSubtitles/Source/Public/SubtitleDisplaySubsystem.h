@@ -27,6 +27,19 @@ public:
 	{
 	}
 
+	bool operator==(const FSubtitleFormat& Other) const
+	{
+		return SubtitleTextSize == Other.SubtitleTextSize
+			&& SubtitleTextColor == Other.SubtitleTextColor
+			&& SubtitleTextBorder == Other.SubtitleTextBorder
+			&& SubtitleBackgroundOpacity == Other.SubtitleBackgroundOpacity;
+	}
+
+	bool operator!=(const FSubtitleFormat& Other) const
+	{
+		return !(*this == Other);
+	}
+
 public:
 	UPROPERTY(EditAnywhere, Category = "Display Info")
 	ESubtitleDisplayTextSize SubtitleTextSize;
@@ -50,6 +63,9 @@ public:
 	DECLARE_EVENT_OneParam(USubtitleDisplaySubsystem, FDisplayFormatChangedEvent, const FSubtitleFormat& /*DisplayFormat*/);
 	FDisplayFormatChangedEvent DisplayFormatChangedEvent;
 
+	DECLARE_EVENT_OneParam(USubtitleDisplaySubsystem, FPrefetchSubtitlesEvent, const TArray<FString>& /*SubtitleTexts*/);
+	FPrefetchSubtitlesEvent PrefetchSubtitlesEvent;
+
 public:
 	static UE_API USubtitleDisplaySubsystem* Get(const ULocalPlayer* LocalPlayer);
 
@@ -64,6 +80,9 @@ public:
 	UE_API void SetSubtitleDisplayOptions(const FSubtitleFormat& InOptions);
 	UE_API const FSubtitleFormat& GetSubtitleDisplayOptions() const;
 
+	/** Lets the subtitle displays get ready for subtitles that are about to be shown, see SSubtitleDisplay::PrefetchSubtitleText. */
+	UE_API void PrefetchSubtitles(const TArray<FString>& SubtitleTexts);
+
 private:
 	UPROPERTY()
 	FSubtitleFormat SubtitleFormat;
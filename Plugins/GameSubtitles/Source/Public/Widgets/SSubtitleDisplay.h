@@ -51,11 +51,26 @@ public:
 	/** See WrapTextAt attribute */
 	UE_API void SetWrapTextAt(const TAttribute<float>& InWrapTextAt);
 
+	/**
+	 * Measures subtitles that are about to be displayed with the current text style, so their font faces are loaded
+	 * and their glyphs shaped before the frame they show up on.  Rich text markup is parsed first, so only the displayed
+	 * text is measured.  Each text is only measured once per style, out of the most recently prefetched ones.
+	 */
+	UE_API void PrefetchSubtitleText(const TArray<FString>& SubtitleTexts);
+
 private:
 	void HandleSubtitleChanged(const FText& SubtitleText);
 
+	void SetBackgroundVisible(bool bVisible);
+
 private:
 
+	/** Copy of the style the text is displayed with, to prefetch with */
+	FTextBlockStyle TextStyle;
+
+	/** Hashes of the texts prefetched with the current style, reset once it holds MaxPrefetchedSubtitles of them */
+	TSet<uint32> PrefetchedSubtitleHashes;
+
 	TSharedPtr<class SBorder> Background;
 
 	/** The actual widget that will display the subtitle text */
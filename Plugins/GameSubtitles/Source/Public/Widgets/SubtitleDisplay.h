@@ -58,6 +58,7 @@ protected:
 	// End UWidget Protected Interface
 
 	UE_API void HandleSubtitleDisplayOptionsChanged(const FSubtitleFormat& InDisplayFormat);
+	UE_API void HandlePrefetchSubtitles(const TArray<FString>& SubtitleTexts);
 	
 private:
 
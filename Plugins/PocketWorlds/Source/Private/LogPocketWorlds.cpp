@@ -0,0 +1,5 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LogPocketWorlds.h"
+
+DEFINE_LOG_CATEGORY(LogPocketLevels);
@@ -164,7 +164,7 @@ TArray<UPrimitiveComponent*> UPocketCapture::GatherPrimitivesForCapture(const TA
 	return PrimitiveComponents;
 }
 
-bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const TArray<AActor*>& InCaptureActors, ESceneCaptureSource InCaptureSource, UMaterialInterface* OverrideMaterial)
+bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const TArray<AActor*>& InCaptureActors, ESceneCaptureSource InCaptureSource, UMaterialInterface* OverrideMaterial, UMaterialInterface* PostProcessMaterial)
 {
 	if (InRenderTarget == nullptr)
 	{
@@ -211,6 +211,12 @@ bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const
 				CaptureComponent->PostProcessSettings = Camera->PostProcessSettings;
 				CaptureComponent->SetCameraView(CaptureView);
 
+				// Masks rendered by a post process material don't need to touch any of the captured components
+				if (PostProcessMaterial)
+				{
+					CaptureComponent->PostProcessSettings.WeightedBlendables.Array.Add(FWeightedBlendable(1.0f, PostProcessMaterial));
+				}
+
 				CaptureComponent->ShowFlags.SetDepthOfField(false);
 				CaptureComponent->ShowFlags.SetMotionBlur(false);
 				CaptureComponent->ShowFlags.SetScreenPercentage(false);
@@ -233,7 +239,7 @@ bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const
 				// Requires resources in the FScene, which get reallocated for every temporary scene if enabled
 				CaptureComponent->ShowFlags.SetIndirectLightingCache(false);
 				CaptureComponent->ShowFlags.SetLightShafts(false);
-				CaptureComponent->ShowFlags.SetPostProcessMaterial(false);
+				CaptureComponent->ShowFlags.SetPostProcessMaterial(PostProcessMaterial != nullptr);
 				CaptureComponent->ShowFlags.SetHighResScreenshotMask(false);
 				CaptureComponent->ShowFlags.SetHMDDistortion(false);
 				CaptureComponent->ShowFlags.SetStereoRendering(false);
@@ -277,44 +283,74 @@ bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const
 
 void UPocketCapture::CaptureDiffuse()
 {
-	if (UTextureRenderTarget2D* RenderTarget = GetOrCreateDiffuseRenderTarget())
-	{
-		TArray<AActor*> CaptureActors;
-		if (AActor* CaptureTarget = CaptureTargetPtr.Get())
-		{
-			CaptureTarget->GetAttachedActors(CaptureActors);
-			CaptureActors.Add(CaptureTarget);
-		}
-
-		CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_FinalColorLDR, nullptr);
-	}
+	Capture(EPocketCaptureType::Diffuse);
 }
 
 void UPocketCapture::CaptureAlphaMask()
 {
-	if (UTextureRenderTarget2D* RenderTarget = GetOrCreateAlphaMaskRenderTarget())
+	Capture(EPocketCaptureType::AlphaMask);
+}
+
+void UPocketCapture::CaptureEffects()
+{
+	Capture(EPocketCaptureType::Effects);
+}
+
+bool UPocketCapture::Capture(EPocketCaptureType CaptureType)
+{
+	switch (CaptureType)
 	{
-		TArray<AActor*> CaptureActors;
-		for (const TWeakObjectPtr<AActor>& AlphaMaskTargetPtr : AlphaMaskActorPtrs)
+	case EPocketCaptureType::Diffuse:
+		if (UTextureRenderTarget2D* RenderTarget = GetOrCreateDiffuseRenderTarget())
+		{
+			TArray<AActor*> CaptureActors;
+			if (AActor* CaptureTarget = CaptureTargetPtr.Get())
+			{
+				CaptureTarget->GetAttachedActors(CaptureActors);
+				CaptureActors.Add(CaptureTarget);
+			}
+
+			return CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_FinalColorLDR, nullptr);
+		}
+		break;
+
+	case EPocketCaptureType::AlphaMask:
+		if (UTextureRenderTarget2D* RenderTarget = GetOrCreateAlphaMaskRenderTarget())
 		{
-			if (AActor* AlphaMaskTarget = AlphaMaskTargetPtr.Get())
+			TArray<AActor*> CaptureActors;
+			for (const TWeakObjectPtr<AActor>& AlphaMaskTargetPtr : AlphaMaskActorPtrs)
+			{
+				if (AActor* AlphaMaskTarget = AlphaMaskTargetPtr.Get())
+				{
+					CaptureActors.Add(AlphaMaskTarget);
+				}
+			}
+
+			if (AlphaMaskPostProcessMaterial)
 			{
-				CaptureActors.Add(AlphaMaskTarget);
+				return CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_FinalColorLDR, nullptr, AlphaMaskPostProcessMaterial);
 			}
+
+			return CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_SceneColorHDR, AlphaMaskMaterial);
 		}
+		break;
 
-		CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_SceneColorHDR, AlphaMaskMaterial);
+	case EPocketCaptureType::Effects:
+		if (UTextureRenderTarget2D* RenderTarget = GetOrCreateEffectsRenderTarget())
+		{
+			ensure(false);//TODO
+			TArray<AActor*> CaptureActors;
+			return CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_SceneColorHDR, EffectMaskMaterial);
+		}
+		break;
 	}
+
+	return false;
 }
 
-void UPocketCapture::CaptureEffects()
+void UPocketCapture::RequestCapture(EPocketCaptureType CaptureType, EPocketCapturePriority Priority)
 {
-	if (UTextureRenderTarget2D* RenderTarget = GetOrCreateEffectsRenderTarget())
-	{
-		ensure(false);//TODO
-		TArray<AActor*> CaptureActors;
-		CaptureScene(RenderTarget, CaptureActors, ESceneCaptureSource::SCS_SceneColorHDR, EffectMaskMaterial);
-	}
+	GetThumbnailSystem()->RequestCapture(this, CaptureType, Priority);
 }
 
 void UPocketCapture::ReleaseResources()
@@ -3,12 +3,44 @@
 #include "PocketCaptureSubsystem.h"
 
 #include "Components/PrimitiveComponent.h"
+#include "Engine/Texture.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "LogPocketWorlds.h"
 #include "PocketCapture.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PocketCaptureSubsystem)
 
 class FSubsystemCollectionBase;
 
+namespace PocketCaptureCVars
+{
+	static float CaptureBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarCaptureBudgetMs(
+		TEXT("PocketWorlds.CaptureBudgetMs"),
+		CaptureBudgetMs,
+		TEXT("Game thread time queued pocket captures can use per frame, at least one capture always runs if any are queued"),
+		ECVF_Default);
+
+	static int32 MaxCapturesPerFrame = 4;
+	static FAutoConsoleVariableRef CVarMaxCapturesPerFrame(
+		TEXT("PocketWorlds.MaxCapturesPerFrame"),
+		MaxCapturesPerFrame,
+		TEXT("Maximum number of queued pocket captures to run per frame (0 = no limit besides the budget)"),
+		ECVF_Default);
+}
+
+static FAutoConsoleCommandWithWorld DumpPocketCaptureStreamingCommand(
+	TEXT("PocketWorlds.DumpStreaming"),
+	TEXT("Logs the components force streamed for pocket captures and their texture memory"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UPocketCaptureSubsystem* Subsystem = World ? World->GetSubsystem<UPocketCaptureSubsystem>() : nullptr)
+		{
+			Subsystem->DumpStreamingStats();
+		}
+	}));
+
 // UPocketCaptureSubsystem
 //---------------------------------------------------------------------------------
 
@@ -25,6 +57,13 @@ void UPocketCaptureSubsystem::Deinitialize()
 {
 	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
 
+	// Nothing will run these anymore
+	TArray<FQueuedCapture> CancelledCaptures = MoveTemp(QueuedCaptures);
+	for (FQueuedCapture& Cancelled : CancelledCaptures)
+	{
+		CompleteCapture(Cancelled.Renderer.Get(), Cancelled.CaptureType, Cancelled.Callbacks, false);
+	}
+
 	for (int32 RendererIndex = 0; RendererIndex < ThumbnailRenderers.Num(); RendererIndex++)
 	{
 		if (UPocketCapture* Renderer = ThumbnailRenderers[RendererIndex].Get())
@@ -34,6 +73,25 @@ void UPocketCaptureSubsystem::Deinitialize()
 	}
 
 	ThumbnailRenderers.Reset();
+
+	// Don't leave anything force streamed once we're gone
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : ForceStreamedComponents)
+	{
+		if (UPrimitiveComponent* PrimitiveComponent = Pair.Key.Get())
+		{
+			PrimitiveComponent->bForceMipStreaming = false;
+		}
+	}
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : StreamRequestsThisFrame)
+	{
+		if (UPrimitiveComponent* PrimitiveComponent = Pair.Key.Get())
+		{
+			PrimitiveComponent->bForceMipStreaming = false;
+		}
+	}
+
+	ForceStreamedComponents.Reset();
+	StreamRequestsThisFrame.Reset();
 }
 
 UPocketCapture* UPocketCaptureSubsystem::CreateThumbnailRenderer(TSubclassOf<UPocketCapture> ThumbnailRendererClass)
@@ -63,6 +121,7 @@ void UPocketCaptureSubsystem::DestroyThumbnailRenderer(UPocketCapture* Thumbnail
 		if (ThumbnailIndex != INDEX_NONE)
 		{
 			ThumbnailRenderers[ThumbnailIndex] = nullptr;
+			CancelCaptures(ThumbnailRenderer);
 			ThumbnailRenderer->Deinitialize();
 		}
 	}
@@ -72,27 +131,218 @@ void UPocketCaptureSubsystem::StreamThisFrame(TArray<UPrimitiveComponent*>& Prim
 {
 	for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
 	{
-		PrimitiveComponent->bForceMipStreaming = true;
-		StreamedLastFrameButNotNext.Remove(PrimitiveComponent);
+		if (PrimitiveComponent == nullptr)
+		{
+			continue;
+		}
+
+		int32& RequestCount = StreamRequestsThisFrame.FindOrAdd(PrimitiveComponent);
+		if (RequestCount++ == 0 && !ForceStreamedComponents.Contains(PrimitiveComponent))
+		{
+			PrimitiveComponent->bForceMipStreaming = true;
+		}
+	}
+}
+
+int64 UPocketCaptureSubsystem::GetForceStreamedTextureMemory() const
+{
+	TSet<UTexture*> Textures;
+	TArray<UTexture*> UsedTextures;
+
+	auto GatherTextures = [&Textures, &UsedTextures](const TMap<TWeakObjectPtr<UPrimitiveComponent>, int32>& Components)
+	{
+		for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : Components)
+		{
+			if (UPrimitiveComponent* PrimitiveComponent = Pair.Key.Get())
+			{
+				UsedTextures.Reset();
+				PrimitiveComponent->GetUsedTextures(UsedTextures, EMaterialQualityLevel::Num);
+				Textures.Append(UsedTextures);
+			}
+		}
+	};
+
+	GatherTextures(ForceStreamedComponents);
+	GatherTextures(StreamRequestsThisFrame);
+
+	int64 TotalBytes = 0;
+	for (UTexture* Texture : Textures)
+	{
+		if (Texture)
+		{
+			TotalBytes += Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+		}
+	}
+
+	return TotalBytes;
+}
+
+void UPocketCaptureSubsystem::DumpStreamingStats() const
+{
+	int32 NumRequestedOnly = 0;
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : StreamRequestsThisFrame)
+	{
+		if (!ForceStreamedComponents.Contains(Pair.Key))
+		{
+			NumRequestedOnly++;
+		}
 	}
 
-	StreamNextFrame.Append(PrimitiveComponents);
+	UE_LOG(LogPocketLevels, Log, TEXT("Pocket captures force stream %d components (%d newly requested this frame), using %.2f MB of textures"),
+		ForceStreamedComponents.Num() + NumRequestedOnly, NumRequestedOnly, GetForceStreamedTextureMemory() / (1024.0 * 1024.0));
+
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : ForceStreamedComponents)
+	{
+		const UPrimitiveComponent* PrimitiveComponent = Pair.Key.Get();
+		UE_LOG(LogPocketLevels, Log, TEXT("  %s: %d request(s) last frame"), *GetPathNameSafe(PrimitiveComponent), Pair.Value);
+	}
 }
 
 bool UPocketCaptureSubsystem::Tick(float DeltaTime)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_URealTimeThumbnailSubsystem_Tick);
 
-	for (TWeakObjectPtr<UPrimitiveComponent> PrimitiveComponent : StreamedLastFrameButNotNext)
+	// Only components nobody asked for again since the last tick change state
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, int32>& Pair : ForceStreamedComponents)
 	{
-		if (PrimitiveComponent.IsValid())
+		if (!StreamRequestsThisFrame.Contains(Pair.Key))
 		{
-			PrimitiveComponent->bForceMipStreaming = false;
+			if (UPrimitiveComponent* PrimitiveComponent = Pair.Key.Get())
+			{
+				PrimitiveComponent->bForceMipStreaming = false;
+			}
 		}
 	}
 
-	StreamedLastFrameButNotNext = MoveTemp(StreamNextFrame);
+	ForceStreamedComponents = MoveTemp(StreamRequestsThisFrame);
+	StreamRequestsThisFrame.Reset();
+
+	// After the streaming update, so the components of these captures stay force streamed through the next frame
+	ProcessCaptureQueue();
 
 	return true;
 }
 
+void UPocketCaptureSubsystem::RequestCapture(UPocketCapture* Renderer, EPocketCaptureType CaptureType, EPocketCapturePriority Priority, FOnPocketCaptureComplete OnComplete)
+{
+	if (Renderer == nullptr)
+	{
+		OnComplete.ExecuteIfBound(nullptr, CaptureType, false);
+		return;
+	}
+
+	// Effects captures don't gather any actors yet, so they could never render anything
+	if (CaptureType == EPocketCaptureType::Effects)
+	{
+		UE_LOG(LogPocketLevels, Warning, TEXT("Pocket capture %s requested an effects capture, which isn't supported"), *GetNameSafe(Renderer));
+		TArray<FOnPocketCaptureComplete> Callbacks;
+		Callbacks.Add(MoveTemp(OnComplete));
+		CompleteCapture(Renderer, CaptureType, Callbacks, false);
+		return;
+	}
+
+	// Merge with a capture that hasn't run yet, it will render the latest state anyway
+	FQueuedCapture* QueuedCapture = QueuedCaptures.FindByPredicate([Renderer, CaptureType](const FQueuedCapture& Queued)
+	{
+		return Queued.Renderer == Renderer && Queued.CaptureType == CaptureType;
+	});
+
+	if (QueuedCapture)
+	{
+		QueuedCapture->Priority = FMath::Max(QueuedCapture->Priority, Priority);
+	}
+	else
+	{
+		QueuedCapture = &QueuedCaptures.AddDefaulted_GetRef();
+		QueuedCapture->Renderer = Renderer;
+		QueuedCapture->CaptureType = CaptureType;
+		QueuedCapture->Priority = Priority;
+		QueuedCapture->RequestOrder = NextCaptureRequestOrder++;
+	}
+
+	if (OnComplete.IsBound())
+	{
+		QueuedCapture->Callbacks.Add(MoveTemp(OnComplete));
+	}
+}
+
+void UPocketCaptureSubsystem::CancelCaptures(UPocketCapture* Renderer)
+{
+	TArray<FQueuedCapture> CancelledCaptures;
+	for (int32 QueueIndex = QueuedCaptures.Num() - 1; QueueIndex >= 0; QueueIndex--)
+	{
+		if (QueuedCaptures[QueueIndex].Renderer == Renderer)
+		{
+			CancelledCaptures.Add(MoveTemp(QueuedCaptures[QueueIndex]));
+			QueuedCaptures.RemoveAt(QueueIndex);
+		}
+	}
+
+	for (FQueuedCapture& Cancelled : CancelledCaptures)
+	{
+		CompleteCapture(Renderer, Cancelled.CaptureType, Cancelled.Callbacks, false);
+	}
+}
+
+void UPocketCaptureSubsystem::ProcessCaptureQueue()
+{
+	if (QueuedCaptures.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UPocketCaptureSubsystem_ProcessCaptureQueue);
+
+	QueuedCaptures.Sort([](const FQueuedCapture& A, const FQueuedCapture& B)
+	{
+		if (A.Priority != B.Priority)
+		{
+			return A.Priority > B.Priority;
+		}
+		return A.RequestOrder < B.RequestOrder;
+	});
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = PocketCaptureCVars::CaptureBudgetMs / 1000.0;
+
+	int32 NumCaptured = 0;
+	while (QueuedCaptures.Num() > 0)
+	{
+		// Always run at least one so the queue can't stall
+		if (NumCaptured > 0)
+		{
+			const bool bOverBudget = (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds;
+			const bool bOverCount = PocketCaptureCVars::MaxCapturesPerFrame > 0 && NumCaptured >= PocketCaptureCVars::MaxCapturesPerFrame;
+			if (bOverBudget || bOverCount)
+			{
+				break;
+			}
+		}
+
+		// Remove before capturing, callbacks are allowed to queue more captures
+		FQueuedCapture Capture = MoveTemp(QueuedCaptures[0]);
+		QueuedCaptures.RemoveAt(0);
+
+		UPocketCapture* Renderer = Capture.Renderer.Get();
+		const bool bSuccess = Renderer && Renderer->Capture(Capture.CaptureType);
+		NumCaptured++;
+
+		CompleteCapture(Renderer, Capture.CaptureType, Capture.Callbacks, bSuccess);
+	}
+
+	UE_LOG(LogPocketLevels, VeryVerbose, TEXT("Ran %d pocket captures in %.2f ms, %d still queued"), NumCaptured, (FPlatformTime::Seconds() - StartTime) * 1000.0, QueuedCaptures.Num());
+}
+
+void UPocketCaptureSubsystem::CompleteCapture(UPocketCapture* Renderer, EPocketCaptureType CaptureType, TArray<FOnPocketCaptureComplete>& Callbacks, bool bSuccess)
+{
+	for (FOnPocketCaptureComplete& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Renderer, CaptureType, bSuccess);
+	}
+
+	if (Renderer)
+	{
+		Renderer->OnCaptureCompleted.Broadcast(Renderer, CaptureType, bSuccess);
+	}
+}
+
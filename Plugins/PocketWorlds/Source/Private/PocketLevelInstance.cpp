@@ -7,7 +7,9 @@
 #include "Engine/LevelStreamingDynamic.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
+#include "LogPocketWorlds.h"
 #include "PocketLevel.h"
+#include "PocketLevelSystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PocketLevelInstance)
 
@@ -16,11 +18,8 @@ UPocketLevelInstance::UPocketLevelInstance()
 
 }
 
-bool UPocketLevelInstance::Initialize(ULocalPlayer* InLocalPlayer, UPocketLevel* InPocketLevel, FVector InSpawnPoint)
+bool UPocketLevelInstance::LoadPocketLevel(FVector InSpawnPoint, bool bVisible, int32 Priority)
 {
-	LocalPlayer = InLocalPlayer;
-	World = LocalPlayer->GetWorld();
-	PocketLevel = InPocketLevel;
 	Bounds = FBoxSphereBounds(FSphere(InSpawnPoint, PocketLevel->Bounds.GetAbsMax()));
 
 	if (ensure(StreamingPocketLevel == nullptr))
@@ -34,6 +33,18 @@ bool UPocketLevelInstance::Initialize(ULocalPlayer* InLocalPlayer, UPocketLevel*
 			{
 				StreamingPocketLevel->OnLevelLoaded.AddUniqueDynamic(this, &ThisClass::HandlePocketLevelLoaded);
 				StreamingPocketLevel->OnLevelShown.AddUniqueDynamic(this, &ThisClass::HandlePocketLevelShown);
+				StreamingPocketLevel->SetPriority(Priority);
+
+				// Level instances start out loaded and visible, prewarmed ones only need to be loaded
+				if (!bVisible)
+				{
+					StreamingPocketLevel->SetShouldBeVisible(false);
+				}
+
+				LoadStartTime = FPlatformTime::Seconds();
+				ShowRequestTime = bVisible ? LoadStartTime : 0.0;
+				bStreamedIn = bVisible;
+				bPrewarmed = !bVisible;
 			}
 
 			return bSuccess;
@@ -43,10 +54,42 @@ bool UPocketLevelInstance::Initialize(ULocalPlayer* InLocalPlayer, UPocketLevel*
 	return false;
 }
 
+void UPocketLevelInstance::UnloadPocketLevel()
+{
+	if (StreamingPocketLevel)
+	{
+		StreamingPocketLevel->bShouldBlockOnUnload = false;
+		StreamingPocketLevel->SetShouldBeLoaded(false);
+		StreamingPocketLevel->OnLevelShown.RemoveAll(this);
+		StreamingPocketLevel->OnLevelLoaded.RemoveAll(this);
+		StreamingPocketLevel = nullptr;
+	}
+
+	bStreamedIn = false;
+	bPrewarmed = false;
+	ShowRequestTime = 0.0;
+}
+
 void UPocketLevelInstance::StreamIn()
 {
+	LastUsedTime = FPlatformTime::Seconds();
+	NumStreamInRequests++;
+
+	// We may have been evicted while streamed out, in which case the subsystem needs to find us a slot again
+	if (StreamingPocketLevel == nullptr)
+	{
+		GetOuterUPocketLevelSubsystem()->LoadPocketLevelInstance(this, true);
+	}
+	else if (!bStreamedIn)
+	{
+		ShowRequestTime = FPlatformTime::Seconds();
+	}
+
+	bStreamedIn = true;
+
 	if (StreamingPocketLevel)
 	{
+		// If this was prewarmed the level is already loaded, so this only has to flip visibility
 		StreamingPocketLevel->SetShouldBeVisible(true);
 		StreamingPocketLevel->SetShouldBeLoaded(true);
 	}
@@ -54,16 +97,37 @@ void UPocketLevelInstance::StreamIn()
 
 void UPocketLevelInstance::StreamOut()
 {
+	LastUsedTime = FPlatformTime::Seconds();
+
+	// Several widgets can show the same (shared) pocket level, only hide it once the last one is done with it
+	if (NumStreamInRequests > 0)
+	{
+		NumStreamInRequests--;
+	}
+
+	if (NumStreamInRequests > 0)
+	{
+		return;
+	}
+
+	bStreamedIn = false;
+	ShowRequestTime = 0.0;
+
 	if (StreamingPocketLevel)
 	{
 		StreamingPocketLevel->SetShouldBeVisible(false);
-		StreamingPocketLevel->SetShouldBeLoaded(false);
+
+		// Keeping it loaded makes the next StreamIn only a visibility change, the subsystem evicts it if it needs the room
+		if (!GetOuterUPocketLevelSubsystem()->bKeepPocketLevelsLoadedWhenHidden)
+		{
+			StreamingPocketLevel->SetShouldBeLoaded(false);
+		}
 	}
 }
 
 FDelegateHandle UPocketLevelInstance::AddReadyCallback(FPocketLevelInstanceEvent::FDelegate Callback)
 {
-	if (StreamingPocketLevel->GetLevelStreamingState() == ELevelStreamingState::LoadedVisible)
+	if (StreamingPocketLevel && StreamingPocketLevel->GetLevelStreamingState() == ELevelStreamingState::LoadedVisible)
 	{
 		Callback.ExecuteIfBound(this);
 	}
@@ -80,18 +144,30 @@ void UPocketLevelInstance::BeginDestroy()
 {
 	Super::BeginDestroy();
 
-	if (StreamingPocketLevel)
+	UnloadPocketLevel();
+}
+
+void UPocketLevelInstance::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Count everything spawned by the pocket level, that's what an instance costs to keep loaded
+	if (ULevel* LoadedLevel = StreamingPocketLevel ? StreamingPocketLevel->GetLoadedLevel() : nullptr)
 	{
-		StreamingPocketLevel->bShouldBlockOnUnload = false;
-		StreamingPocketLevel->SetShouldBeLoaded(false);
-		StreamingPocketLevel->OnLevelShown.RemoveAll(this);
-		StreamingPocketLevel->OnLevelLoaded.RemoveAll(this);
-		StreamingPocketLevel = nullptr;
+		for (AActor* Actor : LoadedLevel->Actors)
+		{
+			if (Actor)
+			{
+				Actor->GetResourceSizeEx(CumulativeResourceSize);
+			}
+		}
 	}
 }
 
 void UPocketLevelInstance::HandlePocketLevelLoaded()
 {
+	UE_LOG(LogPocketLevels, Verbose, TEXT("Pocket level %s loaded in %.1f ms (Prewarmed:%d)"), *GetNameSafe(PocketLevel), (FPlatformTime::Seconds() - LoadStartTime) * 1000.0, (int32)bPrewarmed);
+
 	if (StreamingPocketLevel)
 	{
 		// Make everything in the level setup so that it's setup on the client, and we treat
@@ -110,8 +186,8 @@ void UPocketLevelInstance::HandlePocketLevelLoaded()
 				}
 			}
 
-			// TODO: Don't put ownership over shared pocket spaces.
-			if (LocalPlayer)
+			// Don't put ownership over shared pocket spaces.
+			if (LocalPlayer && !bSharedBetweenPlayers)
 			{
 				if (APlayerController* PC = LocalPlayer->GetPlayerController(GetWorld()))
 				{
@@ -130,6 +206,13 @@ void UPocketLevelInstance::HandlePocketLevelLoaded()
 
 void UPocketLevelInstance::HandlePocketLevelShown()
 {
+	if (ShowRequestTime > 0.0)
+	{
+		GetOuterUPocketLevelSubsystem()->ReportPocketLevelReady(this, FPlatformTime::Seconds() - ShowRequestTime, bPrewarmed);
+		ShowRequestTime = 0.0;
+	}
+	bPrewarmed = false;
+
 	OnReadyEvent.Broadcast(this);
 }
 
@@ -2,11 +2,26 @@
 
 #include "PocketLevelSystem.h"
 
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "LogPocketWorlds.h"
 #include "PocketLevel.h"
 #include "PocketLevelInstance.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PocketLevelSystem)
 
+static FAutoConsoleCommandWithWorld DumpPocketLevelsCommand(
+	TEXT("PocketWorlds.DumpInstances"),
+	TEXT("Logs the state, slot and estimated memory of every pocket level instance"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UPocketLevelSubsystem* Subsystem = World ? World->GetSubsystem<UPocketLevelSubsystem>() : nullptr)
+		{
+			Subsystem->DumpPocketLevelStats();
+		}
+	}));
+
 UPocketLevelInstance* UPocketLevelSubsystem::GetOrCreatePocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint)
 {
 	if (PocketLevel == nullptr)
@@ -14,23 +29,234 @@ UPocketLevelInstance* UPocketLevelSubsystem::GetOrCreatePocketLevelFor(ULocalPla
 		return nullptr;
 	}
 
-	float VerticalBoundsOffset = 0;
+	if (UPocketLevelInstance* ExistingInstance = FindPocketLevelFor(LocalPlayer, PocketLevel))
+	{
+		ExistingInstance->LastUsedTime = FPlatformTime::Seconds();
+
+		// Reload it if it was evicted while nobody was using it
+		if (ExistingInstance->SlotIndex == INDEX_NONE)
+		{
+			LoadPocketLevelInstance(ExistingInstance, true);
+		}
+
+		return ExistingInstance;
+	}
+
+	UPocketLevelInstance* NewInstance = CreatePocketLevelInstance(LocalPlayer, PocketLevel, DesiredSpawnPoint);
+	LoadPocketLevelInstance(NewInstance, true);
+
+	return NewInstance;
+}
+
+UPocketLevelInstance* UPocketLevelSubsystem::PrewarmPocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint, int32 Priority)
+{
+	if (PocketLevel == nullptr)
+	{
+		return nullptr;
+	}
+
+	UPocketLevelInstance* Instance = FindPocketLevelFor(LocalPlayer, PocketLevel);
+	if (Instance && Instance->SlotIndex != INDEX_NONE)
+	{
+		// Already loaded (or loading), nothing to prewarm
+		return Instance;
+	}
+
+	if (Instance == nullptr)
+	{
+		Instance = CreatePocketLevelInstance(LocalPlayer, PocketLevel, DesiredSpawnPoint);
+	}
+
+	if (!LoadPocketLevelInstance(Instance, false, Priority))
+	{
+		UE_LOG(LogPocketLevels, Verbose, TEXT("Skipped prewarming pocket level %s, no room in the pool"), *GetNameSafe(PocketLevel));
+		return nullptr;
+	}
+
+	return Instance;
+}
+
+double UPocketLevelSubsystem::GetAverageTimeToReady(bool bPrewarmed) const
+{
+	const int32 Index = bPrewarmed ? 1 : 0;
+	return NumReadyInstances[Index] > 0 ? TotalSecondsToReady[Index] / NumReadyInstances[Index] : 0.0;
+}
+
+void UPocketLevelSubsystem::ReleaseUnusedPocketLevels()
+{
 	for (UPocketLevelInstance* Instance : PocketInstances)
 	{
-		if (Instance->LocalPlayer == LocalPlayer && Instance->PocketLevel == PocketLevel)
+		if (Instance->SlotIndex != INDEX_NONE && !Instance->bStreamedIn)
 		{
-			return Instance;
+			UnloadPocketLevelInstance(Instance);
 		}
+	}
+}
+
+void UPocketLevelSubsystem::DumpPocketLevelStats() const
+{
+	int64 TotalBytes = 0;
 
-		VerticalBoundsOffset += Instance->PocketLevel->Bounds.Z;
+	UE_LOG(LogPocketLevels, Log, TEXT("Pocket level instances: %d (%d loaded, max %d), %d slots"), PocketInstances.Num(), GetNumLoadedInstances(), MaxLoadedPocketLevels, Slots.Num());
+	for (UPocketLevelInstance* Instance : PocketInstances)
+	{
+		const int64 InstanceBytes = Instance->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		TotalBytes += InstanceBytes;
+
+		UE_LOG(LogPocketLevels, Log, TEXT("  %s: Player:%s, Slot:%d, Offset:%.0f, Loaded:%d, StreamedIn:%d, Users:%d, Shared:%d, Idle:%.1fs, Memory:%.1fKB"),
+			*GetNameSafe(Instance->PocketLevel),
+			*GetNameSafe(Instance->LocalPlayer),
+			Instance->SlotIndex,
+			Slots.IsValidIndex(Instance->SlotIndex) ? Slots[Instance->SlotIndex].Offset : 0.0f,
+			(int32)(Instance->SlotIndex != INDEX_NONE),
+			(int32)Instance->bStreamedIn,
+			Instance->NumStreamInRequests,
+			(int32)Instance->bSharedBetweenPlayers,
+			FPlatformTime::Seconds() - Instance->LastUsedTime,
+			InstanceBytes / 1024.0);
+	}
+	UE_LOG(LogPocketLevels, Log, TEXT("Total pocket level memory: %.1fKB"), TotalBytes / 1024.0);
+	UE_LOG(LogPocketLevels, Log, TEXT("Average time to ready: %.1f ms cold (%d), %.1f ms prewarmed (%d)"), GetAverageTimeToReady(false) * 1000.0, NumReadyInstances[0], GetAverageTimeToReady(true) * 1000.0, NumReadyInstances[1]);
+}
+
+UPocketLevelInstance* UPocketLevelSubsystem::FindPocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel) const
+{
+	for (UPocketLevelInstance* Instance : PocketInstances)
+	{
+		if (Instance->PocketLevel == PocketLevel && (Instance->LocalPlayer == LocalPlayer || (bSharePocketLevelsBetweenPlayers && Instance->bSharedBetweenPlayers)))
+		{
+			return Instance;
+		}
 	}
 
-	const FVector SpawnPoint = DesiredSpawnPoint + FVector(0, 0, VerticalBoundsOffset);
+	return nullptr;
+}
 
+UPocketLevelInstance* UPocketLevelSubsystem::CreatePocketLevelInstance(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint)
+{
 	UPocketLevelInstance* NewInstance = NewObject<UPocketLevelInstance>(this);
-	NewInstance->Initialize(LocalPlayer, PocketLevel, SpawnPoint);
+	NewInstance->LocalPlayer = LocalPlayer;
+	NewInstance->World = LocalPlayer->GetWorld();
+	NewInstance->PocketLevel = PocketLevel;
+	NewInstance->DesiredSpawnPoint = DesiredSpawnPoint;
+	NewInstance->bSharedBetweenPlayers = bSharePocketLevelsBetweenPlayers;
+	NewInstance->LastUsedTime = FPlatformTime::Seconds();
 
 	PocketInstances.Add(NewInstance);
 
 	return NewInstance;
 }
+
+bool UPocketLevelSubsystem::LoadPocketLevelInstance(UPocketLevelInstance* Instance, bool bVisible, int32 Priority)
+{
+	if (MaxLoadedPocketLevels > 0 && GetNumLoadedInstances() >= MaxLoadedPocketLevels)
+	{
+		if (!EvictLeastRecentlyUsedInstance())
+		{
+			if (!bVisible)
+			{
+				return false;
+			}
+
+			UE_LOG(LogPocketLevels, Warning, TEXT("All %d pocket level instances are in use, loading %s anyway"), GetNumLoadedInstances(), *GetNameSafe(Instance->PocketLevel));
+		}
+	}
+
+	Instance->SlotIndex = AllocateSlot(Instance->PocketLevel->Bounds.Z);
+
+	const FVector SpawnPoint = Instance->DesiredSpawnPoint + FVector(0, 0, Slots[Instance->SlotIndex].Offset);
+	if (!Instance->LoadPocketLevel(SpawnPoint, bVisible, Priority))
+	{
+		Slots[Instance->SlotIndex].bInUse = false;
+		Instance->SlotIndex = INDEX_NONE;
+		return false;
+	}
+
+	return true;
+}
+
+void UPocketLevelSubsystem::ReportPocketLevelReady(UPocketLevelInstance* Instance, double SecondsToReady, bool bWasPrewarmed)
+{
+	const int32 Index = bWasPrewarmed ? 1 : 0;
+	NumReadyInstances[Index]++;
+	TotalSecondsToReady[Index] += SecondsToReady;
+
+	UE_LOG(LogPocketLevels, Log, TEXT("Pocket level %s ready in %.1f ms (Prewarmed:%d)"), *GetNameSafe(Instance->PocketLevel), SecondsToReady * 1000.0, (int32)bWasPrewarmed);
+}
+
+bool UPocketLevelSubsystem::EvictLeastRecentlyUsedInstance()
+{
+	UPocketLevelInstance* LeastRecentlyUsed = nullptr;
+	for (UPocketLevelInstance* Instance : PocketInstances)
+	{
+		if (Instance->SlotIndex != INDEX_NONE && !Instance->bStreamedIn)
+		{
+			if (LeastRecentlyUsed == nullptr || Instance->LastUsedTime < LeastRecentlyUsed->LastUsedTime)
+			{
+				LeastRecentlyUsed = Instance;
+			}
+		}
+	}
+
+	if (LeastRecentlyUsed)
+	{
+		UE_LOG(LogPocketLevels, Verbose, TEXT("Evicting pocket level %s for %s"), *GetNameSafe(LeastRecentlyUsed->PocketLevel), *GetNameSafe(LeastRecentlyUsed->LocalPlayer));
+		UnloadPocketLevelInstance(LeastRecentlyUsed);
+		return true;
+	}
+
+	return false;
+}
+
+void UPocketLevelSubsystem::UnloadPocketLevelInstance(UPocketLevelInstance* Instance)
+{
+	Instance->UnloadPocketLevel();
+
+	if (Slots.IsValidIndex(Instance->SlotIndex))
+	{
+		Slots[Instance->SlotIndex].bInUse = false;
+	}
+	Instance->SlotIndex = INDEX_NONE;
+}
+
+int32 UPocketLevelSubsystem::AllocateSlot(float Height)
+{
+	// Reuse the smallest free slot that is big enough
+	int32 BestSlotIndex = INDEX_NONE;
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+	{
+		const FPocketLevelSlot& Slot = Slots[SlotIndex];
+		if (!Slot.bInUse && Slot.Height >= Height && (BestSlotIndex == INDEX_NONE || Slot.Height < Slots[BestSlotIndex].Height))
+		{
+			BestSlotIndex = SlotIndex;
+		}
+	}
+
+	if (BestSlotIndex == INDEX_NONE)
+	{
+		FPocketLevelSlot& NewSlot = Slots.AddDefaulted_GetRef();
+		if (Slots.Num() > 1)
+		{
+			const FPocketLevelSlot& PreviousSlot = Slots[Slots.Num() - 2];
+			NewSlot.Offset = PreviousSlot.Offset + PreviousSlot.Height;
+		}
+		NewSlot.Height = Height;
+		BestSlotIndex = Slots.Num() - 1;
+	}
+
+	Slots[BestSlotIndex].bInUse = true;
+	return BestSlotIndex;
+}
+
+int32 UPocketLevelSubsystem::GetNumLoadedInstances() const
+{
+	int32 NumLoaded = 0;
+	for (const UPocketLevelInstance* Instance : PocketInstances)
+	{
+		if (Instance->SlotIndex != INDEX_NONE)
+		{
+			NumLoaded++;
+		}
+	}
+	return NumLoaded;
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFramework/Actor.h"
+#include "PocketCaptureTypes.h"
 
 #include "PocketCapture.generated.h"
 
@@ -18,6 +19,8 @@ class UTextureRenderTarget2D;
 class UWorld;
 struct FFrame;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FPocketCaptureCompletedDynamic, UPocketCapture*, Renderer, EPocketCaptureType, CaptureType, bool, bSuccess);
+
 UCLASS(MinimalAPI, Abstract, Within=PocketCaptureSubsystem, BlueprintType, Blueprintable)
 class UPocketCapture : public UObject
 {
@@ -58,6 +61,20 @@ public:
 	UFUNCTION(BlueprintCallable)
 	UE_API void CaptureEffects();
 
+	/** Captures immediately, returns true if anything was rendered */
+	UE_API bool Capture(EPocketCaptureType CaptureType);
+
+	/**
+	 * Queues a capture with the subsystem, which runs it under the per-frame capture budget.
+	 * OnCaptureCompleted is broadcast once it has run.
+	 */
+	UFUNCTION(BlueprintCallable)
+	UE_API void RequestCapture(EPocketCaptureType CaptureType, EPocketCapturePriority Priority = EPocketCapturePriority::Normal);
+
+	/** Broadcast when a capture queued with RequestCapture has run */
+	UPROPERTY(BlueprintAssignable)
+	FPocketCaptureCompletedDynamic OnCaptureCompleted;
+
 	UFUNCTION(BlueprintCallable)
 	UE_API virtual void ReleaseResources();
 
@@ -71,7 +88,7 @@ protected:
 	AActor* GetCaptureTarget() const { return CaptureTargetPtr.Get(); }
 	virtual void OnCaptureTargetChanged(AActor* InCaptureTarget) {}
 
-	UE_API bool CaptureScene(UTextureRenderTarget2D* InRenderTarget, const TArray<AActor*>& InCaptureActors, ESceneCaptureSource CaptureSource, UMaterialInterface* OverrideMaterial);
+	UE_API bool CaptureScene(UTextureRenderTarget2D* InRenderTarget, const TArray<AActor*>& InCaptureActors, ESceneCaptureSource CaptureSource, UMaterialInterface* OverrideMaterial, UMaterialInterface* PostProcessMaterial = nullptr);
 
 protected:
 	UE_API TArray<UPrimitiveComponent*> GatherPrimitivesForCapture(const TArray<AActor*>& InCaptureActors) const;
@@ -86,6 +103,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	TObjectPtr<UMaterialInterface> EffectMaskMaterial;
 
+	/**
+	 * Post process material that outputs the alpha mask, e.g. from scene depth or custom stencil (should replace the tonemapper).
+	 * When set, alpha mask captures use it instead of swapping every material of the masked actors to AlphaMaskMaterial.
+	 */
+	UPROPERTY(EditDefaultsOnly)
+	TObjectPtr<UMaterialInterface> AlphaMaskPostProcessMaterial;
+
 protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UWorld> PrivateWorld;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Containers/Ticker.h"
+#include "PocketCaptureTypes.h"
 #include "Subsystems/WorldSubsystem.h"
 
 #include "PocketCaptureSubsystem.generated.h"
@@ -36,13 +37,63 @@ public:
 	UFUNCTION(BlueprintCallable)
 	UE_API void DestroyThumbnailRenderer(UPocketCapture* ThumbnailRenderer);
 
+	/**
+	 * Forces mip streaming on the components until the end of the next frame. Requests are counted per component,
+	 * so components shared by several captures are only changed when the first request comes in or the last one expires.
+	 */
 	UE_API void StreamThisFrame(TArray<UPrimitiveComponent*>& PrimitiveComponents);
 
+	/** Number of components currently force streamed for captures */
+	int32 GetNumForceStreamedComponents() const { return ForceStreamedComponents.Num(); }
+
+	/** Resident memory of the textures used by the force streamed components, walks their materials so don't call every frame */
+	UE_API int64 GetForceStreamedTextureMemory() const;
+
+	/** Logs the force streamed components and their texture memory */
+	UE_API void DumpStreamingStats() const;
+
+	/**
+	 * Queues a capture to run during a later tick, under the per-frame capture budget (PocketWorlds.CaptureBudgetMs).
+	 * Requests for the same renderer and capture type that haven't run yet are merged, keeping the highest priority
+	 * and calling every callback. Higher priorities run first, then oldest first.
+	 */
+	UE_API void RequestCapture(UPocketCapture* Renderer, EPocketCaptureType CaptureType, EPocketCapturePriority Priority, FOnPocketCaptureComplete OnComplete = FOnPocketCaptureComplete());
+
+	/** Removes all queued captures for a renderer, calling their callbacks with bSuccess false */
+	UE_API void CancelCaptures(UPocketCapture* Renderer);
+
+	/** Number of captures waiting to run */
+	int32 GetNumQueuedCaptures() const { return QueuedCaptures.Num(); }
+
 protected:
 	UE_API bool Tick(float DeltaTime);
 
-	TArray<TWeakObjectPtr<UPrimitiveComponent>> StreamNextFrame;
-	TArray<TWeakObjectPtr<UPrimitiveComponent>> StreamedLastFrameButNotNext;
+	/** Runs queued captures in priority order until the frame budget is used up */
+	UE_API void ProcessCaptureQueue();
+
+	/** Calls the callbacks of a queued capture and the renderer's OnCaptureCompleted */
+	UE_API void CompleteCapture(UPocketCapture* Renderer, EPocketCaptureType CaptureType, TArray<FOnPocketCaptureComplete>& Callbacks, bool bSuccess);
+
+	struct FQueuedCapture
+	{
+		TWeakObjectPtr<UPocketCapture> Renderer;
+		EPocketCaptureType CaptureType = EPocketCaptureType::Diffuse;
+		EPocketCapturePriority Priority = EPocketCapturePriority::Normal;
+
+		/** Order the capture was first requested in, to run oldest first within a priority */
+		uint64 RequestOrder = 0;
+
+		TArray<FOnPocketCaptureComplete> Callbacks;
+	};
+
+	TArray<FQueuedCapture> QueuedCaptures;
+	uint64 NextCaptureRequestOrder = 0;
+
+	/** Components requested since the last tick, and by how many captures */
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, int32> StreamRequestsThisFrame;
+
+	/** Components with bForceMipStreaming set by us, and by how many captures they were requested last frame */
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, int32> ForceStreamedComponents;
 
 private:
 	TArray<TWeakObjectPtr<UPocketCapture>> ThumbnailRenderers;
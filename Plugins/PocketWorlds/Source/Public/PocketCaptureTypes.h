@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Delegates/Delegate.h"
+
+#include "PocketCaptureTypes.generated.h"
+
+class UPocketCapture;
+
+/** Which render target of a pocket capture to render */
+UENUM(BlueprintType)
+enum class EPocketCaptureType : uint8
+{
+	Diffuse,
+	AlphaMask,
+	/** Not implemented yet, so it can't be queued with RequestCapture */
+	Effects UMETA(Hidden)
+};
+
+/** Order in which queued captures are run when there are more than fit in a frame */
+UENUM(BlueprintType)
+enum class EPocketCapturePriority : uint8
+{
+	/** Captures that nobody is looking at yet, e.g. thumbnails further down a list */
+	Background,
+	Normal,
+	/** Captures for widgets that are currently on screen */
+	Visible
+};
+
+/** Called when a queued capture has run (or was cancelled, with bSuccess false) */
+DECLARE_DELEGATE_ThreeParams(FOnPocketCaptureComplete, UPocketCapture* /*Renderer*/, EPocketCaptureType /*CaptureType*/, bool /*bSuccess*/);
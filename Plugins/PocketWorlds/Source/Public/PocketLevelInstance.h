@@ -32,8 +32,15 @@ public:
 	UE_API UPocketLevelInstance();
 
 	UE_API virtual void BeginDestroy() override;
+	UE_API virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
+	/** Makes the pocket level visible, loading it first if it wasn't prewarmed or was evicted. Every StreamIn needs a matching StreamOut */
 	UE_API void StreamIn();
+
+	/**
+	 * Releases a StreamIn, the pocket level is hidden once every user has streamed it out. It is unloaded as well,
+	 * unless bKeepPocketLevelsLoadedWhenHidden is set, in which case it stays loaded until the subsystem needs the room
+	 */
 	UE_API void StreamOut();
 
 	UE_API FDelegateHandle AddReadyCallback(FPocketLevelInstanceEvent::FDelegate Callback);
@@ -42,7 +49,11 @@ public:
 	virtual class UWorld* GetWorld() const override { return World; }
 
 private:
-	UE_API bool Initialize(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector SpawnPoint);
+	/** Starts loading the pocket level at this location, called by the subsystem once it has a slot for this instance */
+	UE_API bool LoadPocketLevel(FVector SpawnPoint, bool bVisible, int32 Priority);
+
+	/** Unloads the pocket level, called by the subsystem when evicting this instance */
+	UE_API void UnloadPocketLevel();
 
 	UFUNCTION()
 	UE_API void HandlePocketLevelLoaded();
@@ -67,6 +78,33 @@ private:
 
 	FBoxSphereBounds Bounds;
 
+	/** Spawn point requested when this instance was created, before the slot offset is applied */
+	FVector DesiredSpawnPoint = FVector::ZeroVector;
+
+	/** Slot in the subsystem this instance is loaded in, or INDEX_NONE if it is not loaded */
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Last time this instance was requested or streamed in/out, for LRU eviction */
+	double LastUsedTime = 0.0;
+
+	/** Number of StreamIn calls that haven't been matched by a StreamOut yet */
+	int32 NumStreamInRequests = 0;
+
+	/** True while the level should be visible, instances that are streamed in are never evicted */
+	bool bStreamedIn = false;
+
+	/** True if this instance is shared by all local players, so it doesn't belong to any of them */
+	bool bSharedBetweenPlayers = false;
+
+	/** True if this instance was loaded hidden by a prewarm and hasn't been shown yet */
+	bool bPrewarmed = false;
+
+	/** When the level load was started, for reporting load time */
+	double LoadStartTime = 0.0;
+
+	/** When this instance was asked to become visible, for reporting time to ready. 0 if not waiting to be shown */
+	double ShowRequestTime = 0.0;
+
 	friend class UPocketLevelSubsystem;
 };
 
@@ -14,22 +14,93 @@ class UPocketLevel;
 class UPocketLevelInstance;
 
 /**
- *
+ * Owns the pocket level instances of a world. Loaded instances can be kept in a bounded pool (see MaxLoadedPocketLevels),
+ * the least recently used instance that isn't streamed in is unloaded to make room, and its vertical slot is reused by the next instance.
  */
-UCLASS(MinimalAPI)
+UCLASS(MinimalAPI, Config=Game)
 class UPocketLevelSubsystem : public UWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
 	/**
-	 * 
+	 * Returns the pocket level instance for this player and pocket level, creating and loading it if needed.
+	 * When bSharePocketLevelsBetweenPlayers is set, all local players get the same instance of a pocket level.
 	 */
 	UE_API UPocketLevelInstance* GetOrCreatePocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint);
 
+	/**
+	 * Starts loading a pocket level in the background without showing it, so the StreamIn of a later GetOrCreatePocketLevelFor only has to make it visible.
+	 * Intended for front end idle time, before the screen that uses the pocket level is opened. Levels with a higher priority are streamed first.
+	 * Won't evict instances that are in use, returns null if there is no room in the pool.
+	 */
+	UE_API UPocketLevelInstance* PrewarmPocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint, int32 Priority = 0);
+
+	/** Returns the average time from a pocket level being requested to it being visible, for prewarmed or cold instances */
+	UE_API double GetAverageTimeToReady(bool bPrewarmed) const;
+
+	/** Unloads every pocket level instance that isn't currently streamed in, freeing their memory and slots */
+	UE_API void ReleaseUnusedPocketLevels();
+
+	/** Logs the state, slot and estimated memory of every pocket level instance */
+	UE_API void DumpPocketLevelStats() const;
+
 private:
+	UE_API UPocketLevelInstance* FindPocketLevelFor(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel) const;
+
+	UE_API UPocketLevelInstance* CreatePocketLevelInstance(ULocalPlayer* LocalPlayer, UPocketLevel* PocketLevel, FVector DesiredSpawnPoint);
+
+	/**
+	 * Finds a slot and loads the pocket level of an instance that was created or evicted, evicting another instance if the pool is full.
+	 * Prewarms (bVisible = false) never go over MaxLoadedPocketLevels.
+	 */
+	UE_API bool LoadPocketLevelInstance(UPocketLevelInstance* Instance, bool bVisible, int32 Priority = 0);
+
+	/** Called by instances when they become visible, with how long that took since they were requested */
+	UE_API void ReportPocketLevelReady(UPocketLevelInstance* Instance, double SecondsToReady, bool bWasPrewarmed);
+
+	/** Unloads the least recently used instance that isn't streamed in, returns false if they are all in use */
+	UE_API bool EvictLeastRecentlyUsedInstance();
+
+	/** Unloads an instance and frees its slot */
+	UE_API void UnloadPocketLevelInstance(UPocketLevelInstance* Instance);
+
+	/** Returns a free slot at least this tall, or adds a new one above the existing slots */
+	UE_API int32 AllocateSlot(float Height);
+
+	UE_API int32 GetNumLoadedInstances() const;
+
+	/** Vertical space reserved for one loaded pocket level instance, so instances don't overlap each other */
+	struct FPocketLevelSlot
+	{
+		float Offset = 0.0f;
+		float Height = 0.0f;
+		bool bInUse = false;
+	};
+
+	/** Reserved slots, in increasing offset order. Freed slots are reused instead of growing the stack */
+	TArray<FPocketLevelSlot> Slots;
+
 	UPROPERTY()
 	TArray<TObjectPtr<UPocketLevelInstance>> PocketInstances;
+
+	/** Maximum number of pocket level instances that are loaded at once (0 = unlimited). Instances that are streamed in are never evicted */
+	UPROPERTY(Config)
+	int32 MaxLoadedPocketLevels = 0;
+
+	/** If true, local players share one instance of each pocket level instead of each getting their own */
+	UPROPERTY(Config)
+	bool bSharePocketLevelsBetweenPlayers = false;
+
+	/** If true, StreamOut only hides a pocket level and it stays loaded until it is evicted, trading memory for faster StreamIns */
+	UPROPERTY(Config)
+	bool bKeepPocketLevelsLoadedWhenHidden = false;
+
+	/** Number of instances that became ready and their total time to ready, for cold ([0]) and prewarmed ([1]) instances */
+	int32 NumReadyInstances[2] = { 0, 0 };
+	double TotalSecondsToReady[2] = { 0.0, 0.0 };
+
+	friend class UPocketLevelInstance;
 };
 
 #undef UE_API